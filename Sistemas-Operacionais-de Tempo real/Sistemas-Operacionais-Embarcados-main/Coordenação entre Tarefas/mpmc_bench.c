@@ -0,0 +1,188 @@
+/*
+ * ===========================================
+ * BENCHMARK: FILA MPMC SEM LOCK x MONITOR (mutex + cond)
+ * ===========================================
+ * Objetivo:
+ *   Medir a vazão (itens/s) de uma fila limitada entre P produtores e C
+ *   consumidores, comparando:
+ *     - FilaMonitor: mutex + 2 variáveis de condição, no mesmo estilo do
+ *       monitor Conta de conta_monitor.c;
+ *     - MpmcFila:    fila sem lock com sequência por célula (mpmc_queue.h),
+ *       com as versões bloqueantes que estacionam em futex.
+ *
+ * Cada produtor envia TOTAL_ITENS/P itens (valores 1..n); no fim, a main
+ * envia um item NULL por consumidor ("pílula de veneno") para encerrá-los.
+ * A soma dos itens recebidos é conferida para garantir que nada se perdeu.
+ *
+ * Compilar:
+ *   gcc -O2 -pthread mpmc_bench.c -o mpmc_bench
+ * Executar:
+ *   ./mpmc_bench
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "mpmc_queue.h"
+
+#define CAPACIDADE   1024         // itens na fila (potência de 2)
+#define TOTAL_ITENS  2000000      // itens por configuração
+
+/* ----------------------------------------------------------
+ * Fila "monitor": mutex + variáveis de condição
+ * ---------------------------------------------------------- */
+typedef struct {
+    void **buf;
+    size_t cap, ini, n;
+    pthread_mutex_t mtx;         // exclusão mútua da fila inteira
+    pthread_cond_t nao_cheia;    // produtores esperam aqui
+    pthread_cond_t nao_vazia;    // consumidores esperam aqui
+} FilaMonitor;
+
+void fila_init(FilaMonitor *f, size_t cap) {
+    f->buf = malloc(cap * sizeof(void *));
+    if (f->buf == NULL) { perror("malloc"); exit(1); }
+    f->cap = cap;
+    f->ini = f->n = 0;
+    pthread_mutex_init(&f->mtx, NULL);
+    pthread_cond_init(&f->nao_cheia, NULL);
+    pthread_cond_init(&f->nao_vazia, NULL);
+}
+
+void fila_destroy(FilaMonitor *f) {
+    pthread_mutex_destroy(&f->mtx);
+    pthread_cond_destroy(&f->nao_cheia);
+    pthread_cond_destroy(&f->nao_vazia);
+    free(f->buf);
+}
+
+void fila_enviar(FilaMonitor *f, void *dado) {
+    pthread_mutex_lock(&f->mtx);
+    while (f->n == f->cap)                       // semântica Mesa: reavalia
+        pthread_cond_wait(&f->nao_cheia, &f->mtx);
+    f->buf[(f->ini + f->n) % f->cap] = dado;
+    f->n++;
+    pthread_cond_signal(&f->nao_vazia);
+    pthread_mutex_unlock(&f->mtx);
+}
+
+void *fila_receber(FilaMonitor *f) {
+    pthread_mutex_lock(&f->mtx);
+    while (f->n == 0)
+        pthread_cond_wait(&f->nao_vazia, &f->mtx);
+    void *dado = f->buf[f->ini];
+    f->ini = (f->ini + 1) % f->cap;
+    f->n--;
+    pthread_cond_signal(&f->nao_cheia);
+    pthread_mutex_unlock(&f->mtx);
+    return dado;
+}
+
+/* ----------------------------------------------------------
+ * Threads de teste (parametrizadas pela implementação)
+ * ---------------------------------------------------------- */
+typedef struct {
+    int mpmc;                    // 1 = MpmcFila, 0 = FilaMonitor
+    FilaMonitor *fm;
+    MpmcFila *fq;
+    long itens;                  // produtor: quantos enviar
+    unsigned long long soma;     // consumidor: soma do que recebeu
+} Arg;
+
+static void *produtor(void *p) {
+    Arg *a = p;
+    for (long i = 1; i <= a->itens; i++) {
+        if (a->mpmc) mpmc_enviar(a->fq, (void *)(uintptr_t)i);
+        else         fila_enviar(a->fm, (void *)(uintptr_t)i);
+    }
+    return NULL;
+}
+
+static void *consumidor(void *p) {
+    Arg *a = p;
+    for (;;) {
+        void *d = a->mpmc ? mpmc_receber(a->fq) : fila_receber(a->fm);
+        if (d == NULL)                           // pílula de veneno
+            break;
+        a->soma += (uintptr_t)d;
+    }
+    return NULL;
+}
+
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Roda uma configuração e devolve itens por segundo (ou -1 se a soma não bater).
+static double rodar(int mpmc, int np, int nc) {
+    FilaMonitor fm;
+    MpmcFila fq;
+    if (mpmc) {
+        if (mpmc_init(&fq, CAPACIDADE) != 0) { fprintf(stderr, "mpmc_init falhou\n"); exit(1); }
+    } else {
+        fila_init(&fm, CAPACIDADE);
+    }
+
+    long por_prod = TOTAL_ITENS / np;
+    pthread_t tp[np], tc[nc];
+    Arg ap[np], ac[nc];
+
+    double t0 = agora_s();
+    for (int i = 0; i < nc; i++) {
+        ac[i] = (Arg){ .mpmc = mpmc, .fm = &fm, .fq = &fq };
+        pthread_create(&tc[i], NULL, consumidor, &ac[i]);
+    }
+    for (int i = 0; i < np; i++) {
+        ap[i] = (Arg){ .mpmc = mpmc, .fm = &fm, .fq = &fq, .itens = por_prod };
+        pthread_create(&tp[i], NULL, produtor, &ap[i]);
+    }
+    for (int i = 0; i < np; i++)
+        pthread_join(tp[i], NULL);
+    for (int i = 0; i < nc; i++) {
+        if (mpmc) mpmc_enviar(&fq, NULL);
+        else      fila_enviar(&fm, NULL);
+    }
+    unsigned long long soma = 0;
+    for (int i = 0; i < nc; i++) {
+        pthread_join(tc[i], NULL);
+        soma += ac[i].soma;
+    }
+    double dt = agora_s() - t0;
+
+    if (mpmc) mpmc_destroy(&fq); else fila_destroy(&fm);
+
+    unsigned long long esperado = (unsigned long long)np * por_prod * (por_prod + 1) / 2;
+    if (soma != esperado) {
+        fprintf(stderr, "ERRO: soma %llu != esperado %llu\n", soma, esperado);
+        return -1;
+    }
+    return np * por_prod / dt;
+}
+
+/* ----------------------------------------------------------
+ * Função principal
+ * ---------------------------------------------------------- */
+int main(void) {
+    static const int CONFIG[][2] = {
+        { 1, 1 }, { 2, 2 }, { 4, 4 }, { 8, 8 }, { 16, 16 },
+        { 1, 16 }, { 16, 1 }, { 4, 1 }, { 1, 4 },
+    };
+    int nconfig = (int)(sizeof(CONFIG) / sizeof(CONFIG[0]));
+
+    printf("=== Fila limitada: monitor (mutex+cond) x MPMC sem lock ===\n");
+    printf("Capacidade = %d | Itens por configuração = %d\n\n", CAPACIDADE, TOTAL_ITENS);
+    printf("%5s %5s %16s %16s %8s\n", "prod", "cons", "monitor Mitens/s", "mpmc Mitens/s", "ganho");
+
+    for (int i = 0; i < nconfig; i++) {
+        int np = CONFIG[i][0], nc = CONFIG[i][1];
+        double m = rodar(0, np, nc);
+        double q = rodar(1, np, nc);
+        printf("%5d %5d %16.2f %16.2f %7.2fx\n", np, nc, m / 1e6, q / 1e6, q / m);
+    }
+    return 0;
+}
@@ -0,0 +1,204 @@
+/*
+ * ===========================================
+ * FILA LIMITADA MPMC SEM LOCK (estilo Vyukov)
+ * ===========================================
+ * Objetivo:
+ *   Passar dados entre VÁRIOS produtores e VÁRIOS consumidores sem mutex.
+ *   O monitor de conta_monitor.c protege a fila inteira com um único
+ *   pthread_mutex_t; com muitos produtores todos disputam esse lock. Aqui
+ *   cada posição do vetor tem seu próprio número de sequência e as threads
+ *   só disputam um fetch/CAS no índice de cabeça ou de cauda.
+ *
+ * Como funciona (Dmitry Vyukov, "bounded MPMC queue"):
+ *   - O vetor tem N = potência de 2 células; a célula i começa com seq = i.
+ *   - Produtor na posição pos: se cel.seq == pos, a célula está livre →
+ *     CAS(cauda, pos, pos+1), grava o dado e publica seq = pos+1.
+ *   - Consumidor na posição pos: se cel.seq == pos+1, há dado → CAS(cabeça),
+ *     lê o dado e libera a célula para a próxima volta: seq = pos+N.
+ *   - seq < esperado → fila cheia (produtor) ou vazia (consumidor).
+ *
+ * Versões bloqueantes (mpmc_enviar / mpmc_receber):
+ *   quando a fila está cheia/vazia a thread "estaciona" em um futex
+ *   (ver ../futex_sem.h) e é acordada pelo lado oposto — sem syscall quando
+ *   ninguém está esperando.
+ *
+ * Conceitos usados:
+ *   - atomic_size_t / CAS     → reserva de posição sem lock
+ *   - memory_order_acquire/release → publicação segura do dado da célula
+ *   - futex_wait / futex_wake → bloqueio só quando necessário
+ */
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "../futex_sem.h"   // futex_wait, futex_wake, cpu_relax
+
+#define MPMC_SPIN 64        // tentativas antes de estacionar no futex
+
+/* ----------------------------------------------------------
+ * Estrutura de dados da fila
+ * ---------------------------------------------------------- */
+typedef struct {
+    atomic_size_t seq;               // número de sequência da célula
+    void *dado;                      // item (NULL é reservado pelo usuário, se quiser)
+} MpmcCelula;
+
+typedef struct {
+    _Alignas(64) atomic_size_t cauda;    // próxima posição de escrita (produtores)
+    _Alignas(64) atomic_size_t cabeca;   // próxima posição de leitura (consumidores)
+    _Alignas(64) MpmcCelula *celulas;
+    size_t mascara;                      // N - 1
+    // Estacionamento ("event count"): a palavra do futex guarda uma época
+    // (bits 1..31) e o bit 0 = "pode haver alguém dormindo". Só quem encontra
+    // o bit ligado faz a syscall de wake; quando o wake não encontra ninguém o
+    // bit é desligado, e os próximos envios/recebimentos não entram no kernel.
+    _Alignas(64) atomic_uint ev_espaco;  // produtores esperando espaço
+    _Alignas(64) atomic_uint ev_item;    // consumidores esperando item
+} MpmcFila;
+
+#define MPMC_DORMINDO 1u
+
+/* ----------------------------------------------------------
+ * Inicializa e destrói a fila (capacidade: potência de 2)
+ * ---------------------------------------------------------- */
+static inline int mpmc_init(MpmcFila *f, size_t capacidade) {
+    if (capacidade < 2 || (capacidade & (capacidade - 1)) != 0)
+        return -1;
+    f->celulas = aligned_alloc(64, ((capacidade * sizeof(MpmcCelula) + 63) / 64) * 64);
+    if (f->celulas == NULL)
+        return -1;
+    for (size_t i = 0; i < capacidade; i++) {
+        atomic_init(&f->celulas[i].seq, i);
+        f->celulas[i].dado = NULL;
+    }
+    f->mascara = capacidade - 1;
+    atomic_init(&f->cauda, 0);
+    atomic_init(&f->cabeca, 0);
+    atomic_init(&f->ev_espaco, 0);
+    atomic_init(&f->ev_item, 0);
+    return 0;
+}
+
+static inline void mpmc_destroy(MpmcFila *f) {
+    free(f->celulas);
+    f->celulas = NULL;
+}
+
+/* ----------------------------------------------------------
+ * Operações não bloqueantes (retornam 1 = ok, 0 = cheia/vazia)
+ * ---------------------------------------------------------- */
+static inline int mpmc_tentar_enviar(MpmcFila *f, void *dado) {
+    size_t pos = atomic_load_explicit(&f->cauda, memory_order_relaxed);
+    for (;;) {
+        MpmcCelula *c = &f->celulas[pos & f->mascara];
+        size_t seq = atomic_load_explicit(&c->seq, memory_order_acquire);
+        ptrdiff_t dif = (ptrdiff_t)seq - (ptrdiff_t)pos;
+        if (dif == 0) {
+            // Célula livre nesta volta: tenta reservar a posição.
+            if (atomic_compare_exchange_weak_explicit(&f->cauda, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                c->dado = dado;
+                atomic_store_explicit(&c->seq, pos + 1, memory_order_release);
+                return 1;
+            }
+            // CAS falhou: 'pos' já foi atualizado para a nova cauda.
+        } else if (dif < 0) {
+            return 0;                                   // cheia
+        } else {
+            pos = atomic_load_explicit(&f->cauda, memory_order_relaxed);
+        }
+    }
+}
+
+static inline int mpmc_tentar_receber(MpmcFila *f, void **dado) {
+    size_t pos = atomic_load_explicit(&f->cabeca, memory_order_relaxed);
+    for (;;) {
+        MpmcCelula *c = &f->celulas[pos & f->mascara];
+        size_t seq = atomic_load_explicit(&c->seq, memory_order_acquire);
+        ptrdiff_t dif = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&f->cabeca, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                *dado = c->dado;
+                // Libera a célula para o produtor da PRÓXIMA volta do anel.
+                atomic_store_explicit(&c->seq, pos + f->mascara + 1, memory_order_release);
+                return 1;
+            }
+        } else if (dif < 0) {
+            return 0;                                   // vazia
+        } else {
+            pos = atomic_load_explicit(&f->cabeca, memory_order_relaxed);
+        }
+    }
+}
+
+/* ----------------------------------------------------------
+ * Acorda quem espera do outro lado (só faz syscall se houver alguém)
+ * ---------------------------------------------------------- */
+static inline void mpmc_avisar(atomic_uint *ev) {
+    // seq_cst: par com o fetch_or + nova tentativa de mpmc_estacionar (Dekker):
+    // ou vemos o bit MPMC_DORMINDO, ou quem ia dormir vê o nosso item/espaço.
+    atomic_thread_fence(memory_order_seq_cst);
+    unsigned v = atomic_load_explicit(ev, memory_order_relaxed);
+    if (!(v & MPMC_DORMINDO))
+        return;
+    // Nova época: quem estava entre o fetch_or e o futex_wait recebe EAGAIN e
+    // tenta de novo. Dos que já dormem, acordamos UM (um item → um consumidor).
+    v = atomic_fetch_add(ev, 2) + 2;
+    if (futex_wake(ev, 1, FUTEX_PRIVATE_FLAG) == 0) {
+        // Ninguém dormia: desliga o bit (mudando a época de novo, para que um
+        // retardatário que acabou de ligá-lo também reavalie a fila).
+        atomic_compare_exchange_strong(ev, &v, (v + 2) & ~MPMC_DORMINDO);
+    }
+}
+
+// Anuncia que vai dormir, tenta a operação mais uma vez e, se ainda não der,
+// dorme até a época mudar. Retorna 1 se a última tentativa deu certo.
+#define mpmc_estacionar(ev, tentativa)                                      \
+    ({                                                                      \
+        unsigned _v = atomic_fetch_or((ev), MPMC_DORMINDO) | MPMC_DORMINDO; \
+        int _ok = (tentativa);                                              \
+        if (!_ok)                                                           \
+            futex_wait((ev), _v, NULL, 0, FUTEX_PRIVATE_FLAG);              \
+        _ok;                                                                \
+    })
+
+/* ----------------------------------------------------------
+ * Operações bloqueantes
+ * ----------------------------------------------------------
+ * - Tentam algumas vezes em espaço de usuário;
+ * - Depois anunciam a espera, tentam de novo e, se ainda não der,
+ *   dormem no futex até o lado oposto abrir uma nova época.
+ */
+static inline void mpmc_enviar(MpmcFila *f, void *dado) {
+    for (int i = 0; i < MPMC_SPIN; i++) {
+        if (mpmc_tentar_enviar(f, dado))
+            goto enviado;
+        cpu_relax();
+    }
+    while (!mpmc_estacionar(&f->ev_espaco, mpmc_tentar_enviar(f, dado)))
+        ;
+enviado:
+    mpmc_avisar(&f->ev_item);
+}
+
+static inline void *mpmc_receber(MpmcFila *f) {
+    void *dado;
+    for (int i = 0; i < MPMC_SPIN; i++) {
+        if (mpmc_tentar_receber(f, &dado))
+            goto recebido;
+        cpu_relax();
+    }
+    while (!mpmc_estacionar(&f->ev_item, mpmc_tentar_receber(f, &dado)))
+        ;
+recebido:
+    mpmc_avisar(&f->ev_espaco);
+    return dado;
+}
+
+#endif // MPMC_QUEUE_H
@@ -2,19 +2,36 @@
 // mutex_demo.c
 // Demonstra exclusão mútua com pthreads (mutex) e compara com "race condition".
 // Mostra: init/destroy, lock/unlock, trylock e uso de atributos "ERRORCHECK".
+// Modo "inversao": reproduz a INVERSÃO DE PRIORIDADE (baixa/média/alta na
+// mesma CPU, SCHED_FIFO) e compara os protocolos de mutex
+// PTHREAD_PRIO_NONE, PTHREAD_PRIO_INHERIT e PTHREAD_PRIO_PROTECT.
+// Modo "afinidade": o mesmo lock/unlock com as duas threads posicionadas por
+// política de topologia (cpu_topo.h) e a vazão de cada posicionamento.
 // ----------------------------------------------------------------------------
 // Compilar:   gcc -O2 -pthread mutex_demo.c -o mutex_demo
 // Executar:   ./mutex_demo
 //             ./mutex_demo race        (para ver condição de corrida)
 //             ./mutex_demo trylock     (para ver trylock em ação)
+//             sudo ./mutex_demo inversao [none|inherit|protect] [sched]
+//                                      (sem argumento: roda os três; sem
+//                                       privilégio de RT cai para SCHED_OTHER;
+//                                       "sched" mostra CPU, espera na runqueue
+//                                       e trocas de contexto de cada thread)
+//             ./mutex_demo afinidade [livre|compactar|espalhar|sem_smt|dedicado]
+//                                      (sem argumento: todas as políticas)
 // ============================================================================
 
-#define _POSIX_C_SOURCE 200809L
+#define _GNU_SOURCE               // pthread_attr_setaffinity_np, CPU_SET
 #include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include "../cpu_topo.h"          // topologia e políticas de afinidade
+#include "../sched_stats.h"       // estatísticas de escalonamento por thread
 
 // ----------------------------------------------------------------------------
 // Configuração do experimento
@@ -28,8 +45,9 @@ static int demo_trylock = 0;  // demonstração de trylock
 
 // ----------------------------------------------------------------------------
 // Utilitário: cria mutex com atributo ERRORCHECK (ajuda a achar bugs didáticos)
+// e com o protocolo de prioridade pedido (PTHREAD_PRIO_NONE/INHERIT/PROTECT).
 // ----------------------------------------------------------------------------
-static void criar_mutex_errorcheck(pthread_mutex_t *m) {
+static void criar_mutex_errorcheck(pthread_mutex_t *m, int protocolo, int teto) {
     pthread_mutexattr_t attr;
     pthread_mutexattr_init(&attr);
 
@@ -38,7 +56,26 @@ static void criar_mutex_errorcheck(pthread_mutex_t *m) {
     //  - der lock duas vezes no mesmo mutex (deadlock detectável)
     pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
 
-    int rc = pthread_mutex_init(m, &attr);
+    // Protocolo de prioridade:
+    //  - NONE:    o dono roda na própria prioridade (sujeito à inversão)
+    //  - INHERIT: o dono herda a prioridade da thread mais alta que o espera
+    //  - PROTECT: o dono sobe para o "teto" do mutex assim que o trava
+    // Se o sistema recusar, o mutex ficaria PRIO_NONE em silêncio e a medição
+    // de inversão sairia com o rótulo errado: melhor parar aqui.
+    int rc = pthread_mutexattr_setprotocol(&attr, protocolo);
+    if (rc != 0) {
+        fprintf(stderr, "pthread_mutexattr_setprotocol(%d) falhou: %s\n", protocolo, strerror(rc));
+        exit(1);
+    }
+    if (protocolo == PTHREAD_PRIO_PROTECT) {
+        rc = pthread_mutexattr_setprioceiling(&attr, teto);
+        if (rc != 0) {
+            fprintf(stderr, "pthread_mutexattr_setprioceiling(%d) falhou: %s\n", teto, strerror(rc));
+            exit(1);
+        }
+    }
+
+    rc = pthread_mutex_init(m, &attr);
     pthread_mutexattr_destroy(&attr);
     if (rc != 0) {
         fprintf(stderr, "pthread_mutex_init ERRORCHECK falhou: %s\n", strerror(rc));
@@ -96,12 +133,308 @@ static void* worker(void* arg) {
     return NULL;
 }
 
+// ============================================================================
+// Modo "inversao": inversão de prioridade com três threads na CPU 0
+// ----------------------------------------------------------------------------
+//   t0        BAIXA trava o mutex e precisa de CS_BAIXA_MS de CPU dentro dele
+//   t0+5 ms   ALTA acorda e pede o mesmo mutex → bloqueia (dono = BAIXA)
+//   t0+10 ms  MEDIA acorda e gira MEDIA_MS sem tocar no mutex
+//
+// Com PRIO_NONE a MEDIA (prio 20) preempta a BAIXA (prio 10), que segura o
+// mutex: a ALTA (prio 30) espera também pela MEDIA → inversão "sem limite".
+// Com PRIO_INHERIT/PROTECT a BAIXA roda com prioridade 30 enquanto segura o
+// mutex, a MEDIA não consegue preemptá-la e a ALTA espera só o resto da
+// seção crítica.
+// ============================================================================
+#define PRIO_BAIXA   10
+#define PRIO_MEDIA   20
+#define PRIO_ALTA    30
+#define CS_BAIXA_MS  50    // CPU consumida pela BAIXA dentro do mutex
+#define MEDIA_MS     200   // CPU consumida pela MEDIA (não usa o mutex)
+
+static struct timespec t0_inv;          // instante de partida comum
+static double bloqueio_alta_ms;         // resultado medido pela ALTA
+static double fim_baixa_ms, fim_media_ms;
+static SsColetor *col_inv;              // != NULL: coleta schedstat por thread
+
+static double ms_desde(const struct timespec *ini) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec - ini->tv_sec) * 1e3 + (ts.tv_nsec - ini->tv_nsec) / 1e6;
+}
+
+// Dorme até t0 + deslocamento (relógio absoluto: todas partem da mesma base)
+static void esperar_ate(long desloc_ms) {
+    struct timespec ts = t0_inv;
+    ts.tv_nsec += desloc_ms * 1000000L;
+    ts.tv_sec  += ts.tv_nsec / 1000000000L;
+    ts.tv_nsec %= 1000000000L;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+}
+
+// Gira até a THREAD ter consumido 'ms' de CPU. Medir tempo de CPU (e não de
+// parede) é essencial: se a BAIXA for preemptada, o trabalho dela não anda.
+static void girar_cpu(double ms) {
+    struct timespec ini;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ini);
+    for (;;) {
+        struct timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        if ((ts.tv_sec - ini.tv_sec) * 1e3 + (ts.tv_nsec - ini.tv_nsec) / 1e6 >= ms)
+            break;
+    }
+}
+
+static void* thread_baixa(void* arg) {
+    (void)arg;
+    int slot = col_inv ? ss_registrar(col_inv, "BAIXA") : -1;
+    esperar_ate(0);
+    int rc = pthread_mutex_lock(&mtx);
+    if (rc != 0) {
+        fprintf(stderr, "BAIXA: lock falhou: %s\n", strerror(rc));
+    } else {
+        girar_cpu(CS_BAIXA_MS);                // seção crítica "longa"
+        pthread_mutex_unlock(&mtx);
+        fim_baixa_ms = ms_desde(&t0_inv);
+    }
+    ss_sair(col_inv, slot);
+    return NULL;
+}
+
+static void* thread_media(void* arg) {
+    (void)arg;
+    int slot = col_inv ? ss_registrar(col_inv, "MEDIA") : -1;
+    esperar_ate(10);
+    girar_cpu(MEDIA_MS);                       // só CPU, nenhum recurso
+    fim_media_ms = ms_desde(&t0_inv);
+    ss_sair(col_inv, slot);
+    return NULL;
+}
+
+static void* thread_alta(void* arg) {
+    (void)arg;
+    int slot = col_inv ? ss_registrar(col_inv, "ALTA") : -1;
+    esperar_ate(5);
+    int rc = pthread_mutex_lock(&mtx);
+    // Conta a partir do instante PLANEJADO (t0+5 ms): com PRIO_PROTECT a BAIXA
+    // já roda no teto (30) e a ALTA nem chega a executar até o unlock — a
+    // espera aparece como atraso para acordar, não como tempo dentro do lock.
+    bloqueio_alta_ms = ms_desde(&t0_inv) - 5;
+    if (rc != 0) {
+        fprintf(stderr, "ALTA: lock falhou: %s\n", strerror(rc));
+        bloqueio_alta_ms = -1;
+    } else {
+        pthread_mutex_unlock(&mtx);
+    }
+    ss_sair(col_inv, slot);
+    return NULL;
+}
+
+// Testa se o processo pode usar SCHED_FIFO (root ou CAP_SYS_NICE/RLIMIT_RTPRIO)
+static int tem_privilegio_rt(void) {
+    struct sched_param sp = { .sched_priority = PRIO_BAIXA };
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp) != 0)
+        return 0;
+    sp.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &sp);
+    return 1;
+}
+
+// Cria uma thread presa na CPU 0; com rt = 1 usa SCHED_FIFO com 'prio'.
+static void criar_thread_cpu0(pthread_t *th, void* (*fn)(void*), int rt, int prio) {
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(0, &cpus);
+    pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+
+    if (rt) {
+        struct sched_param sp = { .sched_priority = prio };
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &sp);
+    }
+
+    int rc = pthread_create(th, &attr, fn, NULL);
+    pthread_attr_destroy(&attr);
+    if (rc != 0) {
+        fprintf(stderr, "pthread_create: %s\n", strerror(rc));
+        exit(1);
+    }
+}
+
+static void rodar_inversao(const char *nome, int protocolo, int rt) {
+    criar_mutex_errorcheck(&mtx, protocolo, PRIO_ALTA);
+    bloqueio_alta_ms = fim_baixa_ms = fim_media_ms = 0;
+
+    // Partida daqui a 20 ms: dá tempo de criar as três threads antes de t0.
+    clock_gettime(CLOCK_MONOTONIC, &t0_inv);
+    t0_inv.tv_nsec += 20000000L;
+    t0_inv.tv_sec  += t0_inv.tv_nsec / 1000000000L;
+    t0_inv.tv_nsec %= 1000000000L;
+
+    pthread_t b, m, a;
+    criar_thread_cpu0(&b, thread_baixa, rt, PRIO_BAIXA);
+    criar_thread_cpu0(&a, thread_alta,  rt, PRIO_ALTA);
+    criar_thread_cpu0(&m, thread_media, rt, PRIO_MEDIA);
+    pthread_join(b, NULL);
+    pthread_join(a, NULL);
+    pthread_join(m, NULL);
+    pthread_mutex_destroy(&mtx);
+
+    if (bloqueio_alta_ms < 0)
+        printf("%-8s %12s\n", nome, "falhou");
+    else
+        printf("%-8s %12.1f %14.1f %14.1f\n", nome, bloqueio_alta_ms, fim_baixa_ms, fim_media_ms);
+}
+
+static int demo_inversao(const char *qual, int com_sched) {
+    static const struct { const char *nome; int protocolo; } PROTOCOLOS[] = {
+        { "none",    PTHREAD_PRIO_NONE    },
+        { "inherit", PTHREAD_PRIO_INHERIT },
+        { "protect", PTHREAD_PRIO_PROTECT },
+    };
+
+    int todos = strcmp(qual, "todos") == 0, achou = todos;
+    for (int i = 0; i < 3; i++)
+        achou |= strcmp(qual, PROTOCOLOS[i].nome) == 0;
+    if (!achou) {
+        fprintf(stderr, "protocolo desconhecido: %s (use none, inherit ou protect)\n", qual);
+        return 1;
+    }
+
+    int rt = tem_privilegio_rt();
+    printf("=== DEMO INVERSÃO DE PRIORIDADE ===\n");
+    if (rt) {
+        printf("Política: SCHED_FIFO | prio BAIXA=%d MEDIA=%d ALTA=%d | CPU 0\n",
+               PRIO_BAIXA, PRIO_MEDIA, PRIO_ALTA);
+    } else {
+        printf("⚠️  Sem privilégio para SCHED_FIFO (rode com sudo ou CAP_SYS_NICE).\n");
+        printf("    Usando SCHED_OTHER: o CFS divide a CPU entre as três threads e os\n");
+        printf("    protocolos de mutex praticamente não mudam o resultado.\n");
+    }
+    printf("Seção crítica da BAIXA: %d ms de CPU | MEDIA gira %d ms\n\n", CS_BAIXA_MS, MEDIA_MS);
+    printf("%-8s %12s %14s %14s\n", "mutex", "ALTA esperou", "BAIXA acabou", "MEDIA acabou");
+    printf("%-8s %12s %14s %14s\n", "", "(ms)", "(ms após t0)", "(ms após t0)");
+
+    // Sem coletor periódico (período 0): numa CPU ocupada por SCHED_FIFO ele
+    // nem rodaria. Basta a amostra do registro e a da saída de cada thread.
+    static SsColetor coletas[3];
+    for (int i = 0; i < 3; i++) {
+        if (!todos && strcmp(qual, PROTOCOLOS[i].nome) != 0)
+            continue;
+        if (!rt && PROTOCOLOS[i].protocolo == PTHREAD_PRIO_PROTECT) {
+            // O teto é uma prioridade SCHED_FIFO: sem RT o lock retorna EINVAL.
+            printf("%-8s %12s\n", PROTOCOLOS[i].nome, "(exige SCHED_FIFO)");
+            continue;
+        }
+        if (com_sched) {
+            ss_iniciar(&coletas[i], 0);
+            col_inv = &coletas[i];
+        }
+        rodar_inversao(PROTOCOLOS[i].nome, PROTOCOLOS[i].protocolo, rt);
+        if (col_inv)
+            ss_parar(col_inv);
+        col_inv = NULL;
+    }
+
+    for (int i = 0; i < 3 && com_sched; i++) {
+        if (atomic_load(&coletas[i].n) == 0)
+            continue;
+        printf("\n--- mutex %s ---", PROTOCOLOS[i].nome);
+        ss_relatorio(&coletas[i]);
+    }
+
+    if (rt)
+        printf("\nEsperado: none ≈ %d ms (resto da seção + MEDIA inteira); inherit/protect ≈ %d ms.\n",
+               CS_BAIXA_MS - 5 + MEDIA_MS, CS_BAIXA_MS - 5);
+    return 0;
+}
+
+// ============================================================================
+// Modo "afinidade": vazão do lock/unlock conforme ONDE as threads rodam
+// ----------------------------------------------------------------------------
+// O mutex e o contador vivem numa linha de cache que vai e volta entre as
+// threads a cada lock. Na mesma CPU elas se revezam por fatia de tempo (sem
+// disputa real); em irmãs SMT a linha fica na L1/L2 do core; em cores ou
+// LLCs diferentes cada troca de dono é uma transferência de cache.
+// ============================================================================
+static int demo_afinidade(const char *qual) {
+    Topologia topo;
+    if (topo_ler(&topo) != 0)
+        return 1;
+    int so_uma = qual != NULL ? topo_politica(qual) : -1;
+    if (qual != NULL && so_uma < 0) {
+        fprintf(stderr, "política desconhecida: %s (use livre, compactar, espalhar, sem_smt ou dedicado)\n",
+                qual);
+        return 1;
+    }
+
+    printf("=== DEMO AFINIDADE: lock/unlock com 2 threads x %d iterações ===\n", N_ITERS);
+    topo_imprimir(&topo);
+    printf("\n%-10s %10s %8s %12s %10s\n", "política", "CPUs", "tempo", "lock/s", "resultado");
+    printf("%-10s %10s %8s %12s\n", "", "", "(ms)", "(milhões)");
+
+    use_mutex = 1;
+    demo_trylock = 0;
+    criar_mutex_errorcheck(&mtx, PTHREAD_PRIO_NONE, 0);
+    for (int p = TOPO_LIVRE; p <= TOPO_DEDICADO; p++) {
+        if (so_uma >= 0 && p != so_uma)
+            continue;
+        int cpu[2] = { topo_cpu_para(&topo, p, 0), topo_cpu_para(&topo, p, 1) };
+        if (p == TOPO_DEDICADO && (cpu[0] < 0 || cpu[1] < 0)) {
+            printf("%-10s %10s\n", TOPO_NOMES[p], "(faltam cores)");
+            continue;
+        }
+
+        contador = 0;
+        struct timespec ini;
+        clock_gettime(CLOCK_MONOTONIC, &ini);
+        pthread_t th[2];
+        for (int i = 0; i < 2; i++) {
+            pthread_attr_t attr;
+            pthread_attr_init(&attr);
+            topo_fixar_attr(&attr, cpu[i]);
+            pthread_create(&th[i], &attr, worker, NULL);
+            pthread_attr_destroy(&attr);
+        }
+        for (int i = 0; i < 2; i++)
+            pthread_join(th[i], NULL);
+        double ms = ms_desde(&ini);
+
+        char cpus[16];
+        if (cpu[0] < 0) snprintf(cpus, sizeof(cpus), "kernel");
+        else            snprintf(cpus, sizeof(cpus), "%d,%d", cpu[0], cpu[1]);
+        printf("%-10s %10s %8.1f %12.2f %10s\n", TOPO_NOMES[p], cpus, ms,
+               2.0 * N_ITERS / ms / 1e3, contador == 2LL * N_ITERS ? "ok" : "ERRADO");
+    }
+    pthread_mutex_destroy(&mtx);
+
+    printf("\nEsperado (máquina com SMT e vários cores): compactar (irmãs SMT) mais rápido\n"
+           "que espalhar (cores/LLCs diferentes); com 1 CPU todas as políticas coincidem.\n");
+    return 0;
+}
+
 // ----------------------------------------------------------------------------
 // Programa principal
 // ----------------------------------------------------------------------------
 int main(int argc, char** argv) {
     if (argc > 1) {
-        if (strcmp(argv[1], "race") == 0) {
+        if (strcmp(argv[1], "inversao") == 0) {
+            // Argumentos opcionais em qualquer ordem: protocolo e/ou "sched".
+            const char *qual = "todos";
+            int com_sched = 0;
+            for (int i = 2; i < argc; i++) {
+                if (strcmp(argv[i], "sched") == 0) com_sched = 1;
+                else                               qual = argv[i];
+            }
+            return demo_inversao(qual, com_sched);
+        } else if (strcmp(argv[1], "afinidade") == 0) {
+            return demo_afinidade(argc > 2 ? argv[2] : NULL);
+        } else if (strcmp(argv[1], "race") == 0) {
             use_mutex = 0;
             demo_trylock = 0;
         } else if (strcmp(argv[1], "trylock") == 0) {
@@ -117,7 +450,7 @@ int main(int argc, char** argv) {
     // Inicializa o mutex:
     //   - Poderíamos usar pthread_mutex_init(&mtx, NULL) para o tipo "NORMAL".
     //   - Aqui usamos ERRORCHECK para fins didáticos.
-    criar_mutex_errorcheck(&mtx);
+    criar_mutex_errorcheck(&mtx, PTHREAD_PRIO_NONE, 0);
 
     pthread_t a, b;
     contador = 0;
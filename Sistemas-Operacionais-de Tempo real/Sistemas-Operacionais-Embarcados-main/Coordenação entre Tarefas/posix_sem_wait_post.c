@@ -18,6 +18,9 @@
 // Executar:
 //     ./posix_sem_wait_post
 //
+// Versão com semáforo leve em espaço de usuário (futex, ver ../futex_sem.h):
+//     gcc -O2 -pthread -DUSE_FUTEX_SEM posix_sem_wait_post.c -o posix_sem_wait_post
+//
 // Obs.: Em macOS, sem_init() pode não existir. Nesses casos usa-se semáforo
 // "nomeado" com sem_open() / sem_close() / sem_unlink().
 // -----------------------------------------------------------------------------
@@ -28,6 +31,9 @@
 // “Ative as definições e funções da API POSIX até a versão 200809L.”
 #include <pthread.h>   // threads POSIX
 #include <semaphore.h> // sem_t, sem_init, sem_wait, sem_post, sem_destroy
+#ifdef USE_FUTEX_SEM     // só Linux: <linux/futex.h> não existe no macOS
+#include "../futex_sem.h" // sem_* passa a ser o semáforo futex
+#endif
 #include <stdio.h>     // printf
 #include <stdlib.h>    // rand, srand
 #include <time.h>      // nanosleep, time
@@ -154,7 +160,11 @@ int main(void) {
         return 1;
     }
 
+#ifdef USE_FUTEX_SEM
+    printf("\n=== Semáforo futex (fsem_t, drop-in de sem_t) ===\n");
+#else
     printf("\n=== POSIX Semáforo (sem_t) ===\n");
+#endif
     printf("Capacidade inicial = %d | Threads = %d\n\n", CAP, NTHREADS);
 
     // Cria NTHREADS threads, cada uma executando a função worker()
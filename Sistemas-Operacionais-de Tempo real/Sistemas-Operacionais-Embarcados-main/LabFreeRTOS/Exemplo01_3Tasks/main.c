@@ -2,6 +2,10 @@
 #include <unistd.h> // para usleep() (apenas para exemplo em POSIX)
 #include "FreeRTOS.h"
 #include "task.h"
+#include "runtime_stats.h"   // CPU por task (task Monitor)
+#include "heap_stats.h"      // heap_n escolhido no Makefile (make HEAP=n)
+#include "boot_stats.h"      // objetos do boot estáticos ou no heap (projSTATIC_ALLOC)
+#include "stack_stats.h"     // pico de pilha por task (projPILHA_MONITOR_MS)
 
 /* ---------- Task 1 ---------- */
 void vTaskA(void *pvParameters) {
@@ -27,6 +31,12 @@ void vTaskC(void *pvParameters) {
     }
 }
 
+/* ---------- Buffers do modo estático (projSTATIC_ALLOC=1) ---------- */
+#if ( projSTATIC_ALLOC == 1 )
+static StaticTask_t xTcbA, xTcbB, xTcbC;
+static StackType_t uxPilhaA[projPILHA_TASK], uxPilhaB[projPILHA_TASK], uxPilhaC[projPILHA_TASK];
+#endif
+
 /* ============================ */
 /* Implementações obrigatórias  */
 /* ============================ */
@@ -83,18 +93,28 @@ void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer,
 
 /* Chamado ao iniciar o daemon de timers */
 void vApplicationDaemonTaskStartupHook(void) {
-    // pode deixar vazio também
+    vBootRelatorio();   // RAM dos objetos e tempo até o escalonador
 }
 
 
 /* ---------- Ponto de entrada ---------- */
 int main(void) {
+    /* heap_5: as regiões precisam existir antes da primeira alocação */
+    vHeapIniciar();
+    vBootInicio();
+
     printf("=== FreeRTOS: Exemplo com 3 Tasks ===\n");
 
     /* Cria 3 tasks com diferentes prioridades */
-    xTaskCreate(vTaskA, "TaskA", 1024, NULL, 2, NULL);
-    xTaskCreate(vTaskB, "TaskB", 1024, NULL, 1, NULL);
-    xTaskCreate(vTaskC, "TaskC", 1024, NULL, 1, NULL);
+    xBootTask(vTaskA, "TaskA", projPILHA_TASK, NULL, 2, BOOT_ESTATICO(uxPilhaA), BOOT_ESTATICO(&xTcbA));
+    xBootTask(vTaskB, "TaskB", projPILHA_TASK, NULL, 1, BOOT_ESTATICO(uxPilhaB), BOOT_ESTATICO(&xTcbB));
+    xBootTask(vTaskC, "TaskC", projPILHA_TASK, NULL, 1, BOOT_ESTATICO(uxPilhaC), BOOT_ESTATICO(&xTcbC));
+
+    /* Tabela periódica de CPU% por task */
+    vEstatIniciarMonitor(projRUNTIME_MONITOR_MS);
+
+    /* Pico de pilha por task e tamanho sugerido (0 = desliga) */
+    vPilhaIniciar(projPILHA_MONITOR_MS);
 
     /* Inicia o escalonador */
     vTaskStartScheduler();
@@ -0,0 +1,227 @@
+#include <stdio.h>
+#include <stdlib.h>   // qsort, exit
+#include <time.h>     // clock_gettime (port POSIX)
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "boot_stats.h"   // xBootTask, projPILHA_TASK
+#include "bench_sinal.h"
+
+/* =======================================================================
+ * Ping-pong: semáforo binário x notificação direta x event group
+ * Ping (prioridade 2) sinaliza Pong (prioridade 3), que acorda na hora,
+ * mede a latência give→take e sinaliza de volta. Todos os objetos são
+ * estáticos: sizeof(Static*_t) é exatamente a RAM de cada um.
+ * ======================================================================= */
+
+typedef enum { M_SEMAFORO, M_NOTIFICACAO, M_EVENT_GROUP, N_METODOS } Metodo;
+
+static const char * const pcMetodos[N_METODOS] = { "semaforo", "notificacao", "event group" };
+
+#define BIT_PING    ( 1 << 0 )
+#define BIT_PONG    ( 1 << 1 )
+
+/* ---------- Objetos medidos ---------- */
+
+static StaticSemaphore_t xSemPingBuf, xSemPongBuf;
+static SemaphoreHandle_t xSemPing, xSemPong;
+static StaticEventGroup_t xGrupoBuf;
+static EventGroupHandle_t xGrupo;
+
+/* ---------- Controle (fora da medição) ---------- */
+
+static StaticSemaphore_t xIniPingBuf, xIniPongBuf, xFimBuf;
+static SemaphoreHandle_t xIniPing, xIniPong, xFim;
+static TaskHandle_t xPing, xPong;
+
+#if ( projSTATIC_ALLOC == 1 )
+static StaticTask_t xTcbPing, xTcbPong, xTcbControle;
+static StackType_t uxPilhaPing[projPILHA_TASK], uxPilhaPong[projPILHA_TASK],
+                   uxPilhaControle[projPILHA_TASK];
+#endif
+
+static Metodo eMetodo;
+static volatile uint32_t ulEnvioNs;
+static uint32_t ulLatNs[projBENCH_PINGPONG];
+static uint64_t ullInicioNs, ullFimNs;
+
+static inline uint64_t ullAgoraNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/* ---------- Task Ping ---------- */
+
+static void vTaskPing(void *pvParameters)
+{
+    (void) pvParameters;
+
+    for (;;)
+    {
+        xSemaphoreTake(xIniPing, portMAX_DELAY);
+        ullInicioNs = ullAgoraNs();
+
+        for (uint32_t i = 0; i < projBENCH_PINGPONG; i++)
+        {
+            ulEnvioNs = (uint32_t) ullAgoraNs();
+            switch (eMetodo)
+            {
+                case M_SEMAFORO:
+                    xSemaphoreGive(xSemPing);
+                    xSemaphoreTake(xSemPong, portMAX_DELAY);
+                    break;
+                case M_NOTIFICACAO:
+                    xTaskNotifyGive(xPong);
+                    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                    break;
+                case M_EVENT_GROUP:
+                    xEventGroupSetBits(xGrupo, BIT_PING);
+                    xEventGroupWaitBits(xGrupo, BIT_PONG, pdTRUE, pdFALSE, portMAX_DELAY);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        ullFimNs = ullAgoraNs();
+        xSemaphoreGive(xFim);
+    }
+}
+
+/* ---------- Task Pong ---------- */
+
+static void vTaskPong(void *pvParameters)
+{
+    (void) pvParameters;
+
+    for (;;)
+    {
+        xSemaphoreTake(xIniPong, portMAX_DELAY);
+
+        for (uint32_t i = 0; i < projBENCH_PINGPONG; i++)
+        {
+            switch (eMetodo)
+            {
+                case M_SEMAFORO:
+                    xSemaphoreTake(xSemPing, portMAX_DELAY);
+                    ulLatNs[i] = (uint32_t) ullAgoraNs() - ulEnvioNs;
+                    xSemaphoreGive(xSemPong);
+                    break;
+                case M_NOTIFICACAO:
+                    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                    ulLatNs[i] = (uint32_t) ullAgoraNs() - ulEnvioNs;
+                    xTaskNotifyGive(xPing);
+                    break;
+                case M_EVENT_GROUP:
+                    xEventGroupWaitBits(xGrupo, BIT_PING, pdTRUE, pdFALSE, portMAX_DELAY);
+                    ulLatNs[i] = (uint32_t) ullAgoraNs() - ulEnvioNs;
+                    xEventGroupSetBits(xGrupo, BIT_PONG);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        xSemaphoreGive(xFim);
+    }
+}
+
+/* ---------- Controle ---------- */
+
+static int iCompara(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+/* RAM do mecanismo no ping-pong (2 sentidos). */
+static void vImprimirRam(Metodo m, char *pcBuf, size_t xTam)
+{
+    switch (m)
+    {
+        case M_SEMAFORO:
+            snprintf(pcBuf, xTam, "2 x %u", (unsigned) sizeof(StaticSemaphore_t));
+            break;
+        case M_NOTIFICACAO:
+            /* O valor e o estado já existem em todo TCB. */
+            snprintf(pcBuf, xTam, "0 (TCB)");
+            break;
+        case M_EVENT_GROUP:
+            snprintf(pcBuf, xTam, "1 x %u", (unsigned) sizeof(StaticEventGroup_t));
+            break;
+        default:
+            pcBuf[0] = '\0';
+            break;
+    }
+}
+
+static void vTaskControle(void *pvParameters)
+{
+    (void) pvParameters;
+    char cRam[24];
+
+    printf("\n%d idas e voltas por mecanismo; Pong (prio 3) acorda com o sinal do Ping (prio 2)\n",
+           projBENCH_PINGPONG);
+    printf("%-12s %10s %10s %9s %9s %9s %9s %9s\n", "Mecanismo", "RAM (B)", "idas/s",
+           "lat méd", "lat mín", "lat p50", "lat p99", "lat máx");
+    printf("%-12s %10s %10s %9s %9s %9s %9s %9s\n", "", "", "", "(µs)", "(µs)", "(µs)",
+           "(µs)", "(µs)");
+
+    for (int m = 0; m < N_METODOS; m++)
+    {
+        eMetodo = (Metodo) m;
+
+        /* Pong primeiro: com prioridade maior, já está bloqueado quando o Ping começa. */
+        xSemaphoreGive(xIniPong);
+        xSemaphoreGive(xIniPing);
+        xSemaphoreTake(xFim, portMAX_DELAY);
+        xSemaphoreTake(xFim, portMAX_DELAY);
+
+        double dSeg = (ullFimNs - ullInicioNs) / 1e9;
+        uint64_t ullSoma = 0;
+        for (uint32_t i = 0; i < projBENCH_PINGPONG; i++)
+        {
+            ullSoma += ulLatNs[i];
+        }
+        qsort(ulLatNs, projBENCH_PINGPONG, sizeof(ulLatNs[0]), iCompara);
+
+        vImprimirRam(eMetodo, cRam, sizeof(cRam));
+        printf("%-12s %10s %10.0f %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+               pcMetodos[m], cRam, projBENCH_PINGPONG / dSeg,
+               (double) ullSoma / projBENCH_PINGPONG / 1e3,
+               ulLatNs[0] / 1e3,
+               ulLatNs[projBENCH_PINGPONG / 2] / 1e3,
+               ulLatNs[(projBENCH_PINGPONG * 99) / 100] / 1e3,
+               ulLatNs[projBENCH_PINGPONG - 1] / 1e3);
+        fflush(stdout);
+    }
+
+    printf("\nNotificação: %u índice(s) por task (configTASK_NOTIFICATION_ARRAY_ENTRIES),"
+           " já contados no TCB de %u bytes.\n",
+           (unsigned) configTASK_NOTIFICATION_ARRAY_ENTRIES, (unsigned) sizeof(StaticTask_t));
+    printf("Fim do benchmark.\n");
+    fflush(stdout);
+    exit(0);
+}
+
+void vBenchSinalIniciar(void)
+{
+    xSemPing = xSemaphoreCreateBinaryStatic(&xSemPingBuf);
+    xSemPong = xSemaphoreCreateBinaryStatic(&xSemPongBuf);
+    xGrupo = xEventGroupCreateStatic(&xGrupoBuf);
+
+    xIniPing = xSemaphoreCreateBinaryStatic(&xIniPingBuf);
+    xIniPong = xSemaphoreCreateBinaryStatic(&xIniPongBuf);
+    xFim = xSemaphoreCreateCountingStatic(2, 0, &xFimBuf);
+
+    xPing = xBootTask(vTaskPing, "Ping", projPILHA_TASK, NULL, 2,
+                      BOOT_ESTATICO(uxPilhaPing), BOOT_ESTATICO(&xTcbPing));
+    xPong = xBootTask(vTaskPong, "Pong", projPILHA_TASK, NULL, 3,
+                      BOOT_ESTATICO(uxPilhaPong), BOOT_ESTATICO(&xTcbPong));
+    xBootTask(vTaskControle, "Controle", projPILHA_TASK, NULL, 4,
+              BOOT_ESTATICO(uxPilhaControle), BOOT_ESTATICO(&xTcbControle));
+}
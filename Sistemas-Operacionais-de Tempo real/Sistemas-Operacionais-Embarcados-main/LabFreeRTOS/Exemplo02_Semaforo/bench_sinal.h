@@ -0,0 +1,57 @@
+/*
+ * bench_sinal.h — modos de sinalização do Exemplo 02 (projSINAL no Makefile)
+ *
+ *   0  semáforo binário (xSemaphoreGive / xSemaphoreTake) — a demo original
+ *   1  notificação direta, estilo binário (ulTaskNotifyTake(pdTRUE, ...):
+ *      zera o valor, várias notificações pendentes viram um sinal só)
+ *   2  notificação direta, estilo contador (ulTaskNotifyTake(pdFALSE, ...):
+ *      decrementa, cada xTaskNotifyGive vira um sinal)
+ *   3  benchmark ping-pong: semáforo x notificação x event group, com
+ *      latência give→take, idas e voltas por segundo e RAM de cada um
+ *   4  contagem de eventos em taxa crescente: semáforo binário x semáforo
+ *      contador x valor de notificação acumulado (conta_eventos.c)
+ */
+
+#ifndef BENCH_SINAL_H
+#define BENCH_SINAL_H
+
+#define SINAL_SEMAFORO         0
+#define SINAL_NOTIF_BINARIA    1
+#define SINAL_NOTIF_CONTADOR   2
+#define SINAL_PINGPONG         3
+#define SINAL_CONTAGEM         4
+
+#ifndef projSINAL
+    #define projSINAL    SINAL_SEMAFORO
+#endif
+
+/* Idas e voltas por mecanismo. */
+#ifndef projBENCH_PINGPONG
+    #define projBENCH_PINGPONG    20000
+#endif
+
+/* Modo contagem: taxa inicial (dobra a cada fase), fases, duração de cada
+ * fase, custo de processar um evento e teto do semáforo contador. */
+#ifndef projEVENTO_HZ_INICIAL
+    #define projEVENTO_HZ_INICIAL    125
+#endif
+#ifndef projEVENTO_FASES
+    #define projEVENTO_FASES         5
+#endif
+#ifndef projEVENTO_FASE_MS
+    #define projEVENTO_FASE_MS       1000
+#endif
+#ifndef projEVENTO_CUSTO_US
+    #define projEVENTO_CUSTO_US      2000
+#endif
+#ifndef projEVENTO_MAX_CONTAGEM
+    #define projEVENTO_MAX_CONTAGEM  64
+#endif
+
+/* Cria as tasks do ping-pong; o programa termina no fim da tabela. */
+void vBenchSinalIniciar(void);
+
+/* Cria o gerador e as consumidoras do modo contagem; termina no fim da tabela. */
+void vContagemIniciar(void);
+
+#endif /* BENCH_SINAL_H */
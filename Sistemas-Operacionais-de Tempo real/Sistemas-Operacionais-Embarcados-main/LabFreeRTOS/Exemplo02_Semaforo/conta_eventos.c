@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <stdlib.h>   // exit
+#include <time.h>     // clock_gettime (port POSIX)
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "boot_stats.h"   // xBootTask, projPILHA_TASK
+#include "bench_sinal.h"
+
+/* =======================================================================
+ * Contagem de eventos sem perda (projSINAL = 4)
+ * Um Gerador (prioridade alta, acorda a cada tick, como uma interrupção
+ * periódica) dispara eventos numa taxa que dobra a cada fase. Cada
+ * mecanismo tem sua consumidora, que gasta projEVENTO_CUSTO_US de CPU por
+ * evento:
+ *   binario      xSemaphoreGive num semáforo já dado devolve pdFAIL: o
+ *                evento some (a demo original ignora esse retorno)
+ *   contador     semáforo contador com teto projEVENTO_MAX_CONTAGEM: só
+ *                perde quando a fila de pendentes passa do teto
+ *   notificacao  xTaskNotifyGive soma no valor da task (32 bits); a
+ *                consumidora pega tudo de uma vez com ulTaskNotifyTake(pdTRUE)
+ * Por fase: gerados, observados pela consumidora, perdidos (give que
+ * falhou) e o maior backlog (gerados - perdidos - observados).
+ * ======================================================================= */
+
+typedef enum { M_BINARIO, M_CONTADOR, M_NOTIFICACAO, N_METODOS } Metodo;
+
+static const char * const pcMetodos[N_METODOS] = { "binario", "contador", "notificacao" };
+
+#define DRENAGEM_MAX_MS    10000    /* espera pelo backlog no fim de cada fase */
+
+static SemaphoreHandle_t xBinario, xContador;
+static TaskHandle_t xConsumidora[N_METODOS];
+
+#if ( projSTATIC_ALLOC == 1 )
+static StaticTask_t xTcbConsumidora[N_METODOS], xTcbGerador;
+static StackType_t uxPilhaConsumidora[N_METODOS][projPILHA_TASK], uxPilhaGerador[projPILHA_TASK];
+#endif
+static volatile uint32_t ulObservados[N_METODOS];
+
+/* ---------- Custo de processamento ---------- */
+
+/* Gasta CPU de verdade (relógio da thread: não conta o tempo preemptada). */
+static void vProcessar(uint32_t ulEventos)
+{
+    struct timespec a, b;
+    long long llAlvo = (long long) ulEventos * projEVENTO_CUSTO_US * 1000LL;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &a);
+    do
+    {
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &b);
+    } while ((b.tv_sec - a.tv_sec) * 1000000000LL + (b.tv_nsec - a.tv_nsec) < llAlvo);
+}
+
+/* ---------- Consumidoras (uma por mecanismo, sempre bloqueadas no seu) ---------- */
+
+static void vTaskConsumidoraEventos(void *pvParameters)
+{
+    const Metodo m = (Metodo) (uintptr_t) pvParameters;
+
+    for (;;)
+    {
+        uint32_t ulN = 0;
+
+        switch (m)
+        {
+            case M_BINARIO:
+                ulN = xSemaphoreTake(xBinario, portMAX_DELAY) == pdTRUE ? 1 : 0;
+                break;
+            case M_CONTADOR:
+                ulN = xSemaphoreTake(xContador, portMAX_DELAY) == pdTRUE ? 1 : 0;
+                break;
+            case M_NOTIFICACAO:
+                ulN = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);   // todos os pendentes
+                break;
+            default:
+                break;
+        }
+
+        vProcessar(ulN);
+        ulObservados[m] += ulN;
+    }
+}
+
+/* ---------- Gerador ---------- */
+
+/* Dispara um evento; retorna pdFAIL se ele foi perdido. */
+static BaseType_t xDisparar(Metodo m)
+{
+    switch (m)
+    {
+        case M_BINARIO:
+            return xSemaphoreGive(xBinario);
+        case M_CONTADOR:
+            return xSemaphoreGive(xContador);
+        case M_NOTIFICACAO:
+            return xTaskNotifyGive(xConsumidora[m]);   // sempre pdPASS
+        default:
+            return pdFAIL;
+    }
+}
+
+static void vTaskGerador(void *pvParameters)
+{
+    (void) pvParameters;
+
+    printf("\nCusto por evento %d µs (capacidade ~%d eventos/s), fases de %d ms, "
+           "teto do contador %d\n", projEVENTO_CUSTO_US, 1000000 / projEVENTO_CUSTO_US,
+           projEVENTO_FASE_MS, projEVENTO_MAX_CONTAGEM);
+    printf("%-12s %8s %9s %11s %9s %12s %10s\n", "Mecanismo", "Taxa(Hz)", "Gerados",
+           "Observados", "Perdidos", "Backlog máx", "Pendentes");
+
+    for (int m = 0; m < N_METODOS; m++)
+    {
+        uint32_t ulHz = projEVENTO_HZ_INICIAL;
+
+        for (int f = 0; f < projEVENTO_FASES; f++, ulHz *= 2)
+        {
+            const uint32_t ulTicks = pdMS_TO_TICKS(projEVENTO_FASE_MS);
+            uint32_t ulGerados = 0, ulPerdidos = 0, ulBacklogMax = 0;
+            uint32_t ulObs0 = ulObservados[m];
+            TickType_t xUltimo = xTaskGetTickCount();
+
+            for (uint32_t k = 0; k < ulTicks; k++)
+            {
+                /* Eventos deste tick: acima de 1 por tick eles chegam em rajada. */
+                uint32_t ulAqui = (uint32_t) (((uint64_t) ulHz * (k + 1)) / configTICK_RATE_HZ -
+                                              ((uint64_t) ulHz * k) / configTICK_RATE_HZ);
+                for (uint32_t e = 0; e < ulAqui; e++)
+                {
+                    ulGerados++;
+                    if (xDisparar((Metodo) m) != pdPASS)
+                    {
+                        ulPerdidos++;
+                    }
+                }
+
+                uint32_t ulBacklog = ulGerados - ulPerdidos - (ulObservados[m] - ulObs0);
+                if (ulBacklog > ulBacklogMax)
+                {
+                    ulBacklogMax = ulBacklog;
+                }
+                vTaskDelayUntil(&xUltimo, 1);
+            }
+
+            /* Deixa a consumidora esvaziar o backlog antes da próxima fase. */
+            for (int t = 0; t < DRENAGEM_MAX_MS / 10; t++)
+            {
+                if (ulObservados[m] - ulObs0 + ulPerdidos >= ulGerados)
+                {
+                    break;
+                }
+                vTaskDelay(pdMS_TO_TICKS(10));
+            }
+
+            uint32_t ulObs = ulObservados[m] - ulObs0;
+            printf("%-12s %8lu %9lu %11lu %9lu %12lu %10lu\n", pcMetodos[m],
+                   (unsigned long) ulHz, (unsigned long) ulGerados, (unsigned long) ulObs,
+                   (unsigned long) ulPerdidos, (unsigned long) ulBacklogMax,
+                   (unsigned long) (ulGerados - ulPerdidos - ulObs));
+            fflush(stdout);
+        }
+    }
+
+    printf("\nFim da contagem.\n");
+    fflush(stdout);
+    exit(0);
+}
+
+void vContagemIniciar(void)
+{
+    xBinario = xSemaphoreCreateBinary();
+    xContador = xSemaphoreCreateCounting(projEVENTO_MAX_CONTAGEM, 0);
+    if (xBinario == NULL || xContador == NULL)
+    {
+        printf("Falha ao criar semáforos!\n");
+        return;
+    }
+
+    for (int m = 0; m < N_METODOS; m++)
+    {
+        xConsumidora[m] = xBootTask(vTaskConsumidoraEventos, pcMetodos[m], projPILHA_TASK,
+                                    (void *) (uintptr_t) m, 2,
+                                    BOOT_ESTATICO(uxPilhaConsumidora[m]),
+                                    BOOT_ESTATICO(&xTcbConsumidora[m]));
+    }
+
+    /* Acima das consumidoras: dispara no tick mesmo com elas ocupando a CPU. */
+    xBootTask(vTaskGerador, "Gerador", projPILHA_TASK, NULL, configMAX_PRIORITIES - 2,
+              BOOT_ESTATICO(uxPilhaGerador), BOOT_ESTATICO(&xTcbGerador));
+}
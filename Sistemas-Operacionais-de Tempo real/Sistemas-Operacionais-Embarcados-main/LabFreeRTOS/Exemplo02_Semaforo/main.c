@@ -4,15 +4,53 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"   // necessário para uso de semáforos
+#include "runtime_stats.h"   // CPU por task (task Monitor)
+#include "heap_stats.h"      // heap_n escolhido no Makefile (make HEAP=n)
+#include "boot_stats.h"      // objetos do boot estáticos ou no heap (projSTATIC_ALLOC)
+#include "stack_stats.h"     // pico de pilha por task (projPILHA_MONITOR_MS)
+#include "bench_sinal.h"     // modos de sinalização (projSINAL)
 
 /* =======================================================================
  * Exemplo 02 – Sincronização com Semáforo Binário
  * Demonstra como duas tasks podem se sincronizar usando um semáforo.
  * TaskProdutora dá (xSemaphoreGive) o semáforo.
  * TaskConsumidora pega (xSemaphoreTake) o semáforo antes de executar.
+ * Com projSINAL (Makefile) o mesmo par usa notificação direta à task
+ * (xTaskNotifyGive / ulTaskNotifyTake), no estilo binário ou contador.
  * ======================================================================= */
 
 SemaphoreHandle_t xSemaforo = NULL;
+TaskHandle_t xConsumidora = NULL;   // destino das notificações (projSINAL 1 e 2)
+
+/* Buffers do modo estático (projSTATIC_ALLOC=1) */
+#if ( projSTATIC_ALLOC == 1 )
+static StaticSemaphore_t xSemaforoBuf;
+static StaticTask_t xTcbProdutora, xTcbConsumidora;
+static StackType_t uxPilhaProdutora[projPILHA_TASK], uxPilhaConsumidora[projPILHA_TASK];
+#endif
+
+/* ---------- Sinalização (semáforo ou notificação direta) ---------- */
+static void vSinalizar(void)
+{
+#if ( projSINAL == SINAL_SEMAFORO )
+    xSemaphoreGive(xSemaforo);
+#else
+    /* Incrementa o valor de notificação da consumidora: sem objeto no meio */
+    xTaskNotifyGive(xConsumidora);
+#endif
+}
+
+/* Retorna quantos sinais estavam pendentes (0 = nenhum). */
+static uint32_t ulEsperarSinal(void)
+{
+#if ( projSINAL == SINAL_SEMAFORO )
+    return xSemaphoreTake(xSemaforo, portMAX_DELAY) == pdTRUE ? 1 : 0;
+#elif ( projSINAL == SINAL_NOTIF_BINARIA )
+    return ulTaskNotifyTake(pdTRUE, portMAX_DELAY);    // zera: N pendentes viram 1 ação
+#else
+    return ulTaskNotifyTake(pdFALSE, portMAX_DELAY);   // decrementa: 1 ação por sinal
+#endif
+}
 
 /* ---------- Task Produtora ---------- */
 void vTaskProdutora(void *pvParameters)
@@ -23,8 +61,8 @@ void vTaskProdutora(void *pvParameters)
         printf("[Produtora] Fazendo trabalho e liberando semáforo...\n");
         vTaskDelay(pdMS_TO_TICKS(1000));   // simula algum processamento
 
-        /* Libera o semáforo — sinaliza para a consumidora */
-        xSemaphoreGive(xSemaforo);
+        /* Libera o semáforo (ou notifica) — sinaliza para a consumidora */
+        vSinalizar();
     }
 }
 
@@ -34,10 +72,12 @@ void vTaskConsumidora(void *pvParameters)
     (void) pvParameters;
     for (;;)
     {
-        /* Espera o semáforo ser liberado pela produtora */
-        if (xSemaphoreTake(xSemaforo, portMAX_DELAY) == pdTRUE)
+        /* Espera o semáforo (ou a notificação) da produtora */
+        uint32_t ulPendentes = ulEsperarSinal();
+        if (ulPendentes > 0)
         {
-            printf("  [Consumidora] Recebeu sinal! Executando ação...\n");
+            printf("  [Consumidora] Recebeu sinal (%lu pendente(s))! Executando ação...\n",
+                   (unsigned long) ulPendentes);
             vTaskDelay(pdMS_TO_TICKS(500));
         }
     }
@@ -88,17 +128,32 @@ void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer,
     *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
 }
 
-void vApplicationDaemonTaskStartupHook(void) { }
+void vApplicationDaemonTaskStartupHook(void) { vBootRelatorio(); }
 
 /* =======================================================================
  * Ponto de entrada
  * ======================================================================= */
 int main(void)
 {
-    printf("=== FreeRTOS: Exemplo 02 – Semáforo Binário ===\n");
+    /* heap_5: as regiões precisam existir antes da primeira alocação */
+    vHeapIniciar();
+    vBootInicio();
+
+#if ( projSINAL == SINAL_PINGPONG )
+    printf("=== FreeRTOS: Exemplo 02 – Ping-pong: semáforo x notificação x event group ===\n");
+
+    vBenchSinalIniciar();
+#elif ( projSINAL == SINAL_CONTAGEM )
+    printf("=== FreeRTOS: Exemplo 02 – Contagem de eventos em taxa crescente ===\n");
+
+    vContagemIniciar();
+#else
+    printf("=== FreeRTOS: Exemplo 02 – %s ===\n",
+           projSINAL == SINAL_SEMAFORO ? "Semáforo Binário" :
+           projSINAL == SINAL_NOTIF_BINARIA ? "Notificação (binária)" : "Notificação (contador)");
 
     /* Cria o semáforo binário */
-    xSemaforo = xSemaphoreCreateBinary();
+    xSemaforo = xBootBinario(BOOT_ESTATICO(&xSemaforoBuf));
 
     if (xSemaforo == NULL)
     {
@@ -107,8 +162,17 @@ int main(void)
     }
 
     /* Cria as tasks de Produtora e Consumidora */
-    xTaskCreate(vTaskProdutora, "Produtora", 1024, NULL, 2, NULL);
-    xTaskCreate(vTaskConsumidora, "Consumidora", 1024, NULL, 1, NULL);
+    xBootTask(vTaskProdutora, "Produtora", projPILHA_TASK, NULL, 2,
+              BOOT_ESTATICO(uxPilhaProdutora), BOOT_ESTATICO(&xTcbProdutora));
+    xConsumidora = xBootTask(vTaskConsumidora, "Consumidora", projPILHA_TASK, NULL, 1,
+                             BOOT_ESTATICO(uxPilhaConsumidora), BOOT_ESTATICO(&xTcbConsumidora));
+
+    /* Tabela periódica de CPU% por task */
+    vEstatIniciarMonitor(projRUNTIME_MONITOR_MS);
+#endif /* projSINAL */
+
+    /* Pico de pilha por task e tamanho sugerido (0 = desliga) */
+    vPilhaIniciar(projPILHA_MONITOR_MS);
 
     /* Inicia o escalonador */
     vTaskStartScheduler();
@@ -0,0 +1,309 @@
+#include <stdio.h>
+#include <stdlib.h>   // qsort, exit
+#include <string.h>
+#include <time.h>     // clock_gettime (port POSIX)
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "message_buffer.h"
+#include "stream_buffer.h"
+#include "heap_stats.h"   // projHEAP
+#include "boot_stats.h"   // xBootTask, projPILHA_TASK
+#include "bench_fila.h"
+
+/* Cada medição cria e apaga sua fila/buffer; no heap_1 o vPortFree dá assert. */
+#if ( projQUEUE_BENCH == 1 ) && ( projHEAP == 1 )
+    #error "projQUEUE_BENCH precisa liberar memória: use HEAP=2, 3, 4 ou 5"
+#endif
+
+/* =======================================================================
+ * Benchmark de filas: cópia x pool de ponteiros x message/stream buffer
+ * Os 4 primeiros bytes de cada item levam o instante do envio (32 bits
+ * baixos do CLOCK_MONOTONIC em ns): cabe até no item de 4 bytes e a
+ * subtração sem sinal continua certa quando o contador dá a volta.
+ * ======================================================================= */
+
+#define PROFUNDIDADE    8       /* itens em trânsito (fila, buffers e pool) */
+#define TAM_MAX         1024
+
+typedef enum { M_COPIA, M_POOL, M_MSGBUF, M_STREAM, N_METODOS } Metodo;
+
+static const char * const pcMetodos[N_METODOS] = { "copia", "pool", "msgbuf", "stream" };
+static const size_t xTamanhos[] = { 4, 16, 64, 256, 1024 };
+#define N_TAMANHOS    (sizeof(xTamanhos) / sizeof(xTamanhos[0]))
+
+/* ---------- Estado da medição corrente ---------- */
+
+static Metodo eMetodo;
+static size_t xTam;
+static QueueHandle_t xDados;            /* copia: itens; pool: ponteiros */
+static QueueHandle_t xLivres;           /* pool: blocos devolvidos */
+static MessageBufferHandle_t xMsg;
+static StreamBufferHandle_t xStream;
+
+static uint8_t ucPool[PROFUNDIDADE][TAM_MAX];
+static uint32_t ulLatNs[projBENCH_ITENS];
+static uint64_t ullInicioNs, ullFimNs;
+
+static TaskHandle_t xControle, xProdutora, xConsumidora;
+
+#if ( projSTATIC_ALLOC == 1 )
+static StaticTask_t xTcbProdutora, xTcbConsumidora, xTcbControle;
+static StackType_t uxPilhaProdutora[projPILHA_TASK], uxPilhaConsumidora[projPILHA_TASK],
+                   uxPilhaControle[projPILHA_TASK];
+#endif
+
+static inline uint64_t ullAgoraNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static inline uint32_t ulAgoraNs(void)
+{
+    return (uint32_t) ullAgoraNs();
+}
+
+/* ---------- Produtora ---------- */
+
+static void vProduzir(void)
+{
+    static uint8_t ucItem[TAM_MAX];
+    uint32_t ulT;
+
+    for (uint32_t i = 0; i < projBENCH_ITENS; i++)
+    {
+        if (eMetodo == M_POOL)
+        {
+            uint8_t *pucBloco;
+            xQueueReceive(xLivres, &pucBloco, portMAX_DELAY);
+            memset(pucBloco, (int) i, xTam);            /* "gera o quadro" no bloco */
+            ulT = ulAgoraNs();
+            memcpy(pucBloco, &ulT, sizeof(ulT));
+            xQueueSend(xDados, &pucBloco, portMAX_DELAY);
+            continue;
+        }
+
+        memset(ucItem, (int) i, xTam);                  /* "gera o quadro" local */
+        ulT = ulAgoraNs();
+        memcpy(ucItem, &ulT, sizeof(ulT));
+
+        switch (eMetodo)
+        {
+            case M_COPIA:
+                xQueueSend(xDados, ucItem, portMAX_DELAY);
+                break;
+            case M_MSGBUF:
+                xMessageBufferSend(xMsg, ucItem, xTam, portMAX_DELAY);
+                break;
+            case M_STREAM:
+                xStreamBufferSend(xStream, ucItem, xTam, portMAX_DELAY);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static void vTaskProdutoraBench(void *pvParameters)
+{
+    (void) pvParameters;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        vProduzir();
+        xTaskNotifyGive(xControle);
+    }
+}
+
+/* ---------- Consumidora ---------- */
+
+static void vConsumir(void)
+{
+    static uint8_t ucItem[TAM_MAX];
+    uint32_t ulT;
+
+    for (uint32_t i = 0; i < projBENCH_ITENS; i++)
+    {
+        switch (eMetodo)
+        {
+            case M_COPIA:
+                xQueueReceive(xDados, ucItem, portMAX_DELAY);
+                break;
+            case M_POOL:
+            {
+                uint8_t *pucBloco;
+                xQueueReceive(xDados, &pucBloco, portMAX_DELAY);
+                memcpy(&ulT, pucBloco, sizeof(ulT));
+                ulLatNs[i] = ulAgoraNs() - ulT;
+                xQueueSend(xLivres, &pucBloco, portMAX_DELAY);   /* devolve o bloco */
+                continue;
+            }
+            case M_MSGBUF:
+                xMessageBufferReceive(xMsg, ucItem, sizeof(ucItem), portMAX_DELAY);
+                break;
+            case M_STREAM:
+            {
+                /* Sem fronteiras: junta bytes até completar um item. */
+                size_t xLidos = 0;
+                while (xLidos < xTam)
+                {
+                    xLidos += xStreamBufferReceive(xStream, ucItem + xLidos, xTam - xLidos,
+                                                   portMAX_DELAY);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        memcpy(&ulT, ucItem, sizeof(ulT));
+        ulLatNs[i] = ulAgoraNs() - ulT;
+    }
+    ullFimNs = ullAgoraNs();
+}
+
+static void vTaskConsumidoraBench(void *pvParameters)
+{
+    (void) pvParameters;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        vConsumir();
+        xTaskNotifyGive(xControle);
+    }
+}
+
+/* ---------- Controle ---------- */
+
+static int iCompara(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+/* Cria os objetos do método; retorna pdFAIL se faltou memória. */
+static BaseType_t xPreparar(void)
+{
+    switch (eMetodo)
+    {
+        case M_COPIA:
+            xDados = xQueueCreate(PROFUNDIDADE, xTam);
+            return xDados != NULL;
+        case M_POOL:
+            xDados = xQueueCreate(PROFUNDIDADE, sizeof(uint8_t *));
+            xLivres = xQueueCreate(PROFUNDIDADE, sizeof(uint8_t *));
+            if (xDados == NULL || xLivres == NULL)
+            {
+                return pdFAIL;
+            }
+            for (int i = 0; i < PROFUNDIDADE; i++)
+            {
+                uint8_t *pucBloco = ucPool[i];
+                xQueueSend(xLivres, &pucBloco, 0);
+            }
+            return pdPASS;
+        case M_MSGBUF:
+            /* Cada mensagem ocupa o item + o comprimento (size_t). */
+            xMsg = xMessageBufferCreate(PROFUNDIDADE * (xTam + sizeof(size_t)));
+            return xMsg != NULL;
+        case M_STREAM:
+            /* Acorda a consumidora só com um item inteiro disponível. */
+            xStream = xStreamBufferCreate(PROFUNDIDADE * xTam, xTam);
+            return xStream != NULL;
+        default:
+            return pdFAIL;
+    }
+}
+
+static void vLiberar(void)
+{
+    switch (eMetodo)
+    {
+        case M_POOL:
+            vQueueDelete(xLivres);
+            /* fall through */
+        case M_COPIA:
+            vQueueDelete(xDados);
+            break;
+        case M_MSGBUF:
+            vMessageBufferDelete(xMsg);
+            break;
+        case M_STREAM:
+            vStreamBufferDelete(xStream);
+            break;
+        default:
+            break;
+    }
+}
+
+static void vTaskControle(void *pvParameters)
+{
+    (void) pvParameters;
+
+    printf("\n%d itens por medição, %d em trânsito; latência = envio → recebimento\n",
+           projBENCH_ITENS, PROFUNDIDADE);
+    printf("%-7s %6s %11s %9s %9s %9s %9s %9s\n", "Método", "Tam(B)", "itens/s", "MB/s",
+           "lat méd", "lat p50", "lat p99", "lat máx");
+    printf("%-7s %6s %11s %9s %9s %9s %9s %9s\n", "", "", "", "", "(µs)", "(µs)", "(µs)", "(µs)");
+
+    for (size_t t = 0; t < N_TAMANHOS; t++)
+    {
+        for (int m = 0; m < N_METODOS; m++)
+        {
+            eMetodo = (Metodo) m;
+            xTam = xTamanhos[t];
+
+            if (xPreparar() != pdPASS)
+            {
+                printf("%-7s %6zu   sem memória\n", pcMetodos[m], xTam);
+                continue;
+            }
+
+            /* Dispara as duas e espera as duas terminarem. */
+            ullInicioNs = ullAgoraNs();
+            xTaskNotifyGive(xConsumidora);
+            xTaskNotifyGive(xProdutora);
+            ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+            ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+            vLiberar();
+
+            double dSeg = (ullFimNs - ullInicioNs) / 1e9;
+            uint64_t ullSoma = 0;
+            for (uint32_t i = 0; i < projBENCH_ITENS; i++)
+            {
+                ullSoma += ulLatNs[i];
+            }
+            qsort(ulLatNs, projBENCH_ITENS, sizeof(ulLatNs[0]), iCompara);
+
+            printf("%-7s %6zu %11.0f %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+                   pcMetodos[m], xTam, projBENCH_ITENS / dSeg,
+                   projBENCH_ITENS * (double) xTam / dSeg / 1e6,
+                   (double) ullSoma / projBENCH_ITENS / 1e3,
+                   ulLatNs[projBENCH_ITENS / 2] / 1e3,
+                   ulLatNs[(projBENCH_ITENS * 99) / 100] / 1e3,
+                   ulLatNs[projBENCH_ITENS - 1] / 1e3);
+            fflush(stdout);
+        }
+    }
+
+    printf("\nFim do benchmark.\n");
+    fflush(stdout);
+    exit(0);
+}
+
+void vBenchFilaIniciar(void)
+{
+    /* Produtora e consumidora com a MESMA prioridade: a produtora enche a
+     * fila, bloqueia, a consumidora esvazia (lotes de PROFUNDIDADE itens).
+     * O controle fica acima das duas, mas dorme enquanto elas rodam. */
+    xProdutora = xBootTask(vTaskProdutoraBench, "Produtora", projPILHA_TASK, NULL, 2,
+                           BOOT_ESTATICO(uxPilhaProdutora), BOOT_ESTATICO(&xTcbProdutora));
+    xConsumidora = xBootTask(vTaskConsumidoraBench, "Consumidora", projPILHA_TASK, NULL, 2,
+                             BOOT_ESTATICO(uxPilhaConsumidora), BOOT_ESTATICO(&xTcbConsumidora));
+    xControle = xBootTask(vTaskControle, "Controle", projPILHA_TASK, NULL, 3,
+                          BOOT_ESTATICO(uxPilhaControle), BOOT_ESTATICO(&xTcbControle));
+}
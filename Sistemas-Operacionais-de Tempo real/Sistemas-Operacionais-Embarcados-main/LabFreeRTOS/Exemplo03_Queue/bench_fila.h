@@ -0,0 +1,28 @@
+/*
+ * bench_fila.h — modo benchmark do Exemplo 03 (projQUEUE_BENCH=1 no Makefile)
+ *
+ * A produtora envia o mais rápido possível itens de 4 B a 1 KB por quatro
+ * caminhos e a consumidora mede vazão (itens/s) e latência envio→recebimento:
+ *   copia    xQueueSend/xQueueReceive copiando o item inteiro (2 cópias)
+ *   pool     blocos estáticos: a fila leva só o ponteiro e uma fila de
+ *            retorno devolve o bloco livre à produtora (zero cópia)
+ *   msgbuf   xMessageBufferSend/Receive (cópia + comprimento de cada mensagem)
+ *   stream   xStreamBufferSend/Receive (cópia, sem fronteira de mensagem)
+ */
+
+#ifndef BENCH_FILA_H
+#define BENCH_FILA_H
+
+#ifndef projQUEUE_BENCH
+    #define projQUEUE_BENCH    0
+#endif
+
+/* Itens por medição (método x tamanho). */
+#ifndef projBENCH_ITENS
+    #define projBENCH_ITENS    20000
+#endif
+
+/* Cria a task que roda a tabela toda e encerra o programa no fim. */
+void vBenchFilaIniciar(void);
+
+#endif /* BENCH_FILA_H */
@@ -4,6 +4,11 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"    // necessário para usar filas (queues)
+#include "runtime_stats.h"   // CPU por task (task Monitor)
+#include "heap_stats.h"      // heap_n escolhido no Makefile (make HEAP=n)
+#include "boot_stats.h"      // objetos do boot estáticos ou no heap (projSTATIC_ALLOC)
+#include "stack_stats.h"     // pico de pilha por task (projPILHA_MONITOR_MS)
+#include "bench_fila.h"      // modo benchmark (projQUEUE_BENCH)
 
 /* =======================================================================
  * Exemplo 03 – Comunicação entre Tasks via Fila (Queue)
@@ -13,6 +18,14 @@
 
 QueueHandle_t xFila = NULL;
 
+/* Buffers do modo estático (projSTATIC_ALLOC=1) */
+#if ( projSTATIC_ALLOC == 1 )
+static StaticQueue_t xFilaBuf;
+static uint8_t ucFilaArea[5 * sizeof(int)];
+static StaticTask_t xTcbProdutora, xTcbConsumidora;
+static StackType_t uxPilhaProdutora[projPILHA_TASK], uxPilhaConsumidora[projPILHA_TASK];
+#endif
+
 /* ---------- Task Produtora ---------- */
 void vTaskProdutora(void *pvParameters)
 {
@@ -56,10 +69,15 @@ void vTaskConsumidora(void *pvParameters)
 
 void vApplicationMallocFailedHook(void)
 {
+#if ( projHEAP_BENCH == 1 )
+    /* No benchmark de heap a falha é contada por quem alocou (create → NULL). */
+    return;
+#else
     printf("ERRO: malloc falhou!\n");
     fflush(stdout);
     taskDISABLE_INTERRUPTS();
     for(;;);
+#endif
 }
 
 void vAssertCalled(const char * const pcFileName, unsigned long ulLine)
@@ -95,17 +113,32 @@ void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer,
     *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
 }
 
-void vApplicationDaemonTaskStartupHook(void) { }
+void vApplicationDaemonTaskStartupHook(void) { vBootRelatorio(); }
 
 /* =======================================================================
  * Ponto de entrada
  * ======================================================================= */
 int main(void)
 {
+    /* heap_5: as regiões precisam existir antes da primeira alocação */
+    vHeapIniciar();
+    vBootInicio();
+
+#if ( projQUEUE_BENCH == 1 )
+    printf("=== FreeRTOS: Exemplo 03 – Benchmark de filas (4 B a 1 KB) ===\n");
+
+    /* Produtora/consumidora na velocidade máxima + task de controle */
+    vBenchFilaIniciar();
+#elif ( projHEAP_BENCH == 1 )
+    printf("=== FreeRTOS: Exemplo 03 – Benchmark de alocação (heap_%d) ===\n", projHEAP);
+
+    /* Cria e apaga filas, timers, message buffers e blocos de tamanhos sorteados */
+    vHeapBenchIniciar();
+#else
     printf("=== FreeRTOS: Exemplo 03 – Comunicação com Fila ===\n");
 
     /* Cria uma fila com 5 elementos do tipo int */
-    xFila = xQueueCreate(5, sizeof(int));
+    xFila = xBootFila(5, sizeof(int), BOOT_ESTATICO(ucFilaArea), BOOT_ESTATICO(&xFilaBuf));
 
     if (xFila == NULL)
     {
@@ -113,9 +146,26 @@ int main(void)
         return -1;
     }
 
+    /* Nome visto por depuradores e pelo trace (traceQUEUE_REGISTRY_ADD) */
+    vQueueAddToRegistry(xFila, "Fila");
+
     /* Cria as tasks */
-    xTaskCreate(vTaskProdutora, "Produtora", 1024, NULL, 2, NULL);
-    xTaskCreate(vTaskConsumidora, "Consumidora", 1024, NULL, 1, NULL);
+    xBootTask(vTaskProdutora, "Produtora", projPILHA_TASK, NULL, 2,
+              BOOT_ESTATICO(uxPilhaProdutora), BOOT_ESTATICO(&xTcbProdutora));
+    xBootTask(vTaskConsumidora, "Consumidora", projPILHA_TASK, NULL, 1,
+              BOOT_ESTATICO(uxPilhaConsumidora), BOOT_ESTATICO(&xTcbConsumidora));
+
+    /* Tabela periódica de CPU% por task */
+    vEstatIniciarMonitor(projRUNTIME_MONITOR_MS);
+#endif /* projQUEUE_BENCH / projHEAP_BENCH */
+
+#if ( projENABLE_RING_TRACE == 1 )
+    /* Eventos do kernel em trace.bin depois de projTRACE_DUMP_MS (make trace2json) */
+    vTraceIniciar(projTRACE_DUMP_MS, "trace.bin");
+#endif
+
+    /* Pico de pilha por task e tamanho sugerido (0 = desliga) */
+    vPilhaIniciar(projPILHA_MONITOR_MS);
 
     /* Inicia o escalonador */
     vTaskStartScheduler();
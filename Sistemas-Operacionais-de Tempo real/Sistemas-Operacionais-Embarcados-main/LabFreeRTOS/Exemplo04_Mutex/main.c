@@ -1,28 +1,175 @@
 #include <stdio.h>
+#include <stdarg.h>   // va_list (vEnviarLinha)
 #include <unistd.h>   // usleep() no ambiente POSIX
 
 #include "FreeRTOS.h"
 #include "task.h"
+#include "queue.h"    // fila de saída do Gatekeeper
 #include "semphr.h"   // necessário para mutex
+#include "runtime_stats.h"   // CPU por task (task Monitor)
+#include "heap_stats.h"      // heap_n escolhido no Makefile (make HEAP=n)
+#include "boot_stats.h"      // objetos do boot estáticos ou no heap (projSTATIC_ALLOC)
+#include "stack_stats.h"     // pico de pilha por task (projPILHA_MONITOR_MS)
 
 /* =======================================================================
  * Exemplo 04 – Proteção de recurso compartilhado com Mutex
  * Demonstra como várias tarefas podem usar um mesmo recurso (printf)
  * sem interferência, garantindo exclusão mútua.
+ * Com projGATEKEEPER=1 ninguém segura o stdout: uma task Gatekeeper é a
+ * dona dele e as outras (inclusive o Relatorio) enviam linhas pré-formatadas
+ * por uma fila; Monitor e Pilhas ficam desligados nesse modo.
+ * vTaskRelatorio mostra rodadas por task, maior bloqueio e tempo de posse.
  * ======================================================================= */
 
+#ifndef projGATEKEEPER
+    #define projGATEKEEPER    0
+#endif
+
+#ifndef projRELATORIO_MS
+    #define projRELATORIO_MS  10000   // período da tabela de métricas (0 = desliga)
+#endif
+
+#define MSG_TAM       96   // linha pré-formatada enviada ao Gatekeeper
+#define MSG_FILA      16   // linhas em espera na fila de saída
+
 SemaphoreHandle_t xMutex;  // handle global do mutex
+QueueHandle_t xFilaSaida;  // projGATEKEEPER: linhas para o Gatekeeper
+
+/* ---------- Métricas ---------- */
+
+/* Por task: rodadas completas, maior espera para conseguir o recurso (take
+ * do mutex ou envio para a fila cheia) e tempo de posse do recurso. */
+typedef struct
+{
+    const char *nome;
+    uint32_t ulRodadas;
+    uint32_t ulBloqueioMaxUs;
+    uint32_t ulPosseMaxUs;
+    uint64_t ullPosseTotalUs;
+    uint32_t ulPosses;
+} Metricas;
+
+static Metricas xMetricas[] =
+{
+    { .nome = "TaskA" }, { .nome = "TaskB" }, { .nome = "TaskC" }, { .nome = "Gatekeeper" }
+};
+#define N_PRINT    3   // as três primeiras são as vTaskPrint
+
+/* Buffers do modo estático (projSTATIC_ALLOC=1) */
+#if ( projSTATIC_ALLOC == 1 )
+#if ( projGATEKEEPER == 1 )
+static StaticQueue_t xFilaSaidaBuf;
+static uint8_t ucFilaSaidaArea[MSG_FILA * MSG_TAM];
+static StaticTask_t xTcbGatekeeper;
+static StackType_t uxPilhaGatekeeper[projPILHA_TASK];
+#else
+static StaticSemaphore_t xMutexBuf;
+#endif
+static StaticTask_t xTcbPrint[N_PRINT], xTcbRelatorio;
+static StackType_t uxPilhaPrint[N_PRINT][projPILHA_TASK], uxPilhaRelatorio[projPILHA_TASK];
+#endif
+
+static uint32_t ulAgoraUs(void)
+{
+    return (uint32_t) ulGetRunTimeCounterValue();   // µs (runtime_stats.c)
+}
+
+static void vRegistrarBloqueio(Metricas *m, uint32_t ulUs)
+{
+    if (ulUs > m->ulBloqueioMaxUs)
+    {
+        m->ulBloqueioMaxUs = ulUs;
+    }
+}
+
+static void vRegistrarPosse(Metricas *m, uint32_t ulUs)
+{
+    m->ullPosseTotalUs += ulUs;
+    m->ulPosses++;
+    if (ulUs > m->ulPosseMaxUs)
+    {
+        m->ulPosseMaxUs = ulUs;
+    }
+}
 
 /* ---------- Task que usa o recurso ---------- */
+#if ( projGATEKEEPER == 1 )
+
+/* Formata a linha na pilha da task e entrega ao Gatekeeper: quem imprime
+ * é só ele. Fila e não message buffer: message buffer admite um único
+ * escritor, e aqui são quatro. m == NULL: não entra nas métricas (Relatorio). */
+static void vEnviarLinha(Metricas *m, const char *pcFormato, ...)
+{
+    char cMsg[MSG_TAM];
+    va_list ap;
+
+    va_start(ap, pcFormato);
+    vsnprintf(cMsg, sizeof(cMsg), pcFormato, ap);
+    va_end(ap);
+
+    uint32_t ulT0 = ulAgoraUs();
+    xQueueSend(xFilaSaida, cMsg, portMAX_DELAY);   // só bloqueia com a fila cheia
+    if (m != NULL)
+    {
+        vRegistrarBloqueio(m, ulAgoraUs() - ulT0);
+    }
+}
+
+void vTaskPrint(void *pvParameters)
+{
+    Metricas *m = (Metricas *) pvParameters;
+    const char *nome = m->nome;
+
+    for (;;)
+    {
+        /* Sem seção crítica: o trabalho (vTaskDelay) não segura nada */
+        vEnviarLinha(m, "[%s] começou a rodada\n", nome);
+        for (int i = 0; i < 3; i++)
+        {
+            vEnviarLinha(m, "  [%s] imprimindo linha %d\n", nome, i + 1);
+            vTaskDelay(pdMS_TO_TICKS(300)); // simula trabalho
+        }
+        vEnviarLinha(m, "[%s] terminou a rodada\n\n", nome);
+        m->ulRodadas++;
+
+        /* Espera um pouco antes da próxima rodada */
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+}
+
+/* ---------- Gatekeeper: única task que toca no stdout ---------- */
+void vTaskGatekeeper(void *pvParameters)
+{
+    Metricas *m = (Metricas *) pvParameters;
+    char cMsg[MSG_TAM];
+
+    for (;;)
+    {
+        xQueueReceive(xFilaSaida, cMsg, portMAX_DELAY);
+
+        uint32_t ulT0 = ulAgoraUs();
+        fputs(cMsg, stdout);
+        fflush(stdout);
+        vRegistrarPosse(m, ulAgoraUs() - ulT0);
+    }
+}
+
+#else /* projGATEKEEPER == 0: mutex segurado durante a rodada inteira */
+
 void vTaskPrint(void *pvParameters)
 {
-    const char *nome = (const char *) pvParameters;
+    Metricas *m = (Metricas *) pvParameters;
+    const char *nome = m->nome;
 
     for (;;)
     {
         /* Tenta pegar o mutex (espera indefinidamente) */
+        uint32_t ulT0 = ulAgoraUs();
         if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE)
         {
+            uint32_t ulT1 = ulAgoraUs();
+            vRegistrarBloqueio(m, ulT1 - ulT0);
+
             /* Início da seção crítica */
             printf("[%s] entrou na seção crítica\n", nome);
             for (int i = 0; i < 3; i++)
@@ -34,7 +181,9 @@ void vTaskPrint(void *pvParameters)
             /* Fim da seção crítica */
 
             /* Libera o mutex para que outras tasks possam usar */
+            vRegistrarPosse(m, ulAgoraUs() - ulT1);
             xSemaphoreGive(xMutex);
+            m->ulRodadas++;
         }
 
         /* Espera um pouco antes de tentar novamente */
@@ -42,6 +191,49 @@ void vTaskPrint(void *pvParameters)
     }
 }
 
+#endif /* projGATEKEEPER */
+
+/* ---------- Relatório periódico ---------- */
+
+/* No mutex imprime direto (instrumento, fora do recurso disputado: o mutex
+ * protege só as rodadas). No gatekeeper o stdout é do Gatekeeper: um printf
+ * daqui (prioridade 3) poderia preemptá-lo dentro do fputs, com o lock do
+ * stdout da glibc na mão, e inflar a posse medida. */
+#if ( projGATEKEEPER == 1 )
+    #define RELATORIO( ... )    vEnviarLinha( NULL, __VA_ARGS__ )
+#else
+    #define RELATORIO( ... )    printf( __VA_ARGS__ )
+#endif
+
+void vTaskRelatorio(void *pvParameters)
+{
+    (void) pvParameters;
+    const uint32_t ulInicio = ulAgoraUs();
+
+    for (;;)
+    {
+        vTaskDelay(pdMS_TO_TICKS(projRELATORIO_MS));
+
+        double dSeg = (ulAgoraUs() - ulInicio) / 1e6;
+        RELATORIO("\n--- %s, t = %.0f s ---\n", projGATEKEEPER ? "Gatekeeper" : "Mutex", dSeg);
+        RELATORIO("%-11s %8s %10s %13s %13s %13s\n", "Task", "Rodadas", "rodadas/min",
+               "bloq máx(ms)", "posse méd(ms)", "posse máx(ms)");
+        for (int i = 0; i < (projGATEKEEPER ? N_PRINT + 1 : N_PRINT); i++)
+        {
+            const Metricas *m = &xMetricas[i];
+            RELATORIO("%-11s %8lu %10.1f %13.3f %13.3f %13.3f\n", m->nome,
+                   (unsigned long) m->ulRodadas, m->ulRodadas * 60.0 / dSeg,
+                   m->ulBloqueioMaxUs / 1e3,
+                   m->ulPosses ? (double) m->ullPosseTotalUs / m->ulPosses / 1e3 : 0.0,
+                   m->ulPosseMaxUs / 1e3);
+        }
+        RELATORIO("\n");
+#if ( projGATEKEEPER == 0 )
+        fflush(stdout);
+#endif
+    }
+}
+
 /* =======================================================================
  * Hooks obrigatórios (mínimos para o port POSIX)
  * ======================================================================= */
@@ -86,17 +278,41 @@ void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer,
     *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
 }
 
-void vApplicationDaemonTaskStartupHook(void) { }
+void vApplicationDaemonTaskStartupHook(void) { vBootRelatorio(); }
 
 /* =======================================================================
  * Ponto de entrada
  * ======================================================================= */
 int main(void)
 {
+    /* heap_5: as regiões precisam existir antes da primeira alocação */
+    vHeapIniciar();
+    vBootInicio();
+
+#if ( projGATEKEEPER == 1 )
+    printf("=== FreeRTOS: Exemplo 04 – Gatekeeper ===\n");
+
+    /* Fila de linhas prontas: o Gatekeeper é o único que imprime */
+    xFilaSaida = xBootFila(MSG_FILA, MSG_TAM, BOOT_ESTATICO(ucFilaSaidaArea),
+                           BOOT_ESTATICO(&xFilaSaidaBuf));
+
+    if (xFilaSaida == NULL)
+    {
+        printf("Falha ao criar fila!\n");
+        return -1;
+    }
+
+    /* Nome visto por depuradores e pelo trace (traceQUEUE_REGISTRY_ADD) */
+    vQueueAddToRegistry(xFilaSaida, "Saida");
+
+    /* Prioridade abaixo das produtoras: imprime quando elas estão dormindo */
+    xBootTask(vTaskGatekeeper, "Gatekeeper", projPILHA_TASK, &xMetricas[N_PRINT], 1,
+              BOOT_ESTATICO(uxPilhaGatekeeper), BOOT_ESTATICO(&xTcbGatekeeper));
+#else
     printf("=== FreeRTOS: Exemplo 04 – Mutex ===\n");
 
     /* Cria o mutex */
-    xMutex = xSemaphoreCreateMutex();
+    xMutex = xBootMutex(BOOT_ESTATICO(&xMutexBuf));
 
     if (xMutex == NULL)
     {
@@ -104,10 +320,43 @@ int main(void)
         return -1;
     }
 
+    /* Nome visto por depuradores e pelo trace (traceQUEUE_REGISTRY_ADD) */
+    vQueueAddToRegistry(xMutex, "Mutex");
+#endif
+
     /* Cria três tarefas que compartilham o printf */
-    xTaskCreate(vTaskPrint, "TaskA", 1024, "TaskA", 2, NULL);
-    xTaskCreate(vTaskPrint, "TaskB", 1024, "TaskB", 2, NULL);
-    xTaskCreate(vTaskPrint, "TaskC", 1024, "TaskC", 2, NULL);
+    for (int i = 0; i < N_PRINT; i++)
+    {
+        xBootTask(vTaskPrint, xMetricas[i].nome, projPILHA_TASK, &xMetricas[i], 2,
+                  BOOT_ESTATICO(uxPilhaPrint[i]), BOOT_ESTATICO(&xTcbPrint[i]));
+    }
+
+    /* Métricas dos dois desenhos (rodadas, bloqueio, posse) */
+    if (projRELATORIO_MS > 0)
+    {
+        xBootTask(vTaskRelatorio, "Relatorio", projPILHA_TASK, NULL, 3,
+                  BOOT_ESTATICO(uxPilhaRelatorio), BOOT_ESTATICO(&xTcbRelatorio));
+    }
+
+#if ( projGATEKEEPER == 1 )
+    /* Monitor e Pilhas imprimem direto e em prioridade alta: desligados para
+     * que o Gatekeeper seja o único a tocar no stdout */
+    if (projRUNTIME_MONITOR_MS > 0 || projPILHA_MONITOR_MS > 0)
+    {
+        printf("(gatekeeper: Monitor e Pilhas desligados)\n");
+    }
+#else
+    /* Tabela periódica de CPU% por task */
+    vEstatIniciarMonitor(projRUNTIME_MONITOR_MS);
+#endif
+
+#if ( projENABLE_RING_TRACE == 1 )
+    /* Eventos do kernel em trace.bin depois de projTRACE_DUMP_MS (make trace2json) */
+    vTraceIniciar(projTRACE_DUMP_MS, "trace.bin");
+#endif
+
+    /* Pico de pilha por task e tamanho sugerido (0 = desliga) */
+    vPilhaIniciar(projGATEKEEPER ? 0 : projPILHA_MONITOR_MS);
 
     /* Inicia o escalonador */
     vTaskStartScheduler();
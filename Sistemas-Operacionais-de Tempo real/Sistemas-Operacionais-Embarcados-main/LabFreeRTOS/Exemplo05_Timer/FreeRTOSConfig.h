@@ -44,13 +44,13 @@
 #define configUSE_DAEMON_TASK_STARTUP_HOOK         1
 #define configTICK_RATE_HZ                         ( 1000 )                  /* In this non-real time simulated environment the tick frequency has to be at least a multiple of the Win32 tick frequency, and therefore very slow. */
 #define configMINIMAL_STACK_SIZE                   ( PTHREAD_STACK_MIN ) /* The stack size being passed is equal to the minimum stack size needed by pthread_create(). */
-#define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( 65 * 1024 ) )
+#define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( projHEAP_KB * 1024 ) ) /* Only used by heap_1/2/4/5 (make HEAP=n), see projHEAP_KB below. */
 #define configMAX_TASK_NAME_LEN                    ( 12 )
 #define configUSE_TRACE_FACILITY                   1
 #define configUSE_16_BIT_TICKS                     0
 #define configIDLE_SHOULD_YIELD                    1
 #define configUSE_MUTEXES                          1
-#define configCHECK_FOR_STACK_OVERFLOW             0
+#define configCHECK_FOR_STACK_OVERFLOW             projCHECK_STACK_OVERFLOW /* See projCHECK_STACK_OVERFLOW below. */
 #define configUSE_RECURSIVE_MUTEXES                1
 #define configQUEUE_REGISTRY_SIZE                  20
 #define configUSE_APPLICATION_TASK_TAG             1
@@ -92,6 +92,12 @@
 unsigned long ulGetRunTimeCounterValue( void ); /* Prototype of function that returns run time counter. */
 void vConfigureTimerForRunTimeStats( void );    /* Prototype of function that initialises the run time counter. */
 #define configGENERATE_RUN_TIME_STATS             1
+#define configRUN_TIME_COUNTER_TYPE               unsigned long
+
+/* Contador de alta resolução (CLOCK_MONOTONIC em µs, ../common/runtime_stats.c).
+ * A forma ALT tem precedência sobre o portGET_RUN_TIME_COUNTER_VALUE() do port
+ * POSIX, que usa times() e só avança de 10 em 10 ms. */
+#define portALT_GET_RUN_TIME_COUNTER_VALUE( ulValor )    ( ulValor ) = ulGetRunTimeCounterValue()
 
 /* Co-routine related configuration options. */
 #define configUSE_CO_ROUTINES                     0
@@ -148,6 +154,22 @@ extern void vAssertCalled( const char * const pcFileName,
     #error projENABLE_TRACING should be defined to 1 or 0 on the command line.
 #endif
 
+/* Tamanho do heap do FreeRTOS (heap_1/2/4/5; o heap_3 usa o malloc da libc).
+ * No port POSIX a pilha é em palavras de 8 bytes: cada task das demos
+ * (projPILHA_TASK, padrão 2112 palavras: o piso do port, boot_stats.h) ocupa
+ * ~16,5 KB e o Monitor (2 x PTHREAD_STACK_MIN palavras) 256 KB. */
+#ifndef projHEAP_KB
+    #define projHEAP_KB    1024
+#endif
+
+/* Detecção de estouro de pilha (hook em stack_stats.c), conferida a cada
+ * troca de contexto: 1 compara o ponteiro de pilha salvo com o limite — no
+ * port POSIX o ponteiro salvo não é o do pthread e nada é detectado; 2 confere
+ * também os 16 bytes de 0xa5 no fim da pilha, o que funciona aqui. */
+#ifndef projCHECK_STACK_OVERFLOW
+    #define projCHECK_STACK_OVERFLOW    0
+#endif
+
 #if ( projCOVERAGE_TEST == 1 )
 
 /* Insert NOPs in empty decision paths to ensure both true and false paths
@@ -4,16 +4,27 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"   // necessário para Software Timers
+#include "runtime_stats.h"   // CPU por task (task Monitor)
+#include "heap_stats.h"      // heap_n escolhido no Makefile (make HEAP=n)
+#include "boot_stats.h"      // objetos do boot estáticos ou no heap (projSTATIC_ALLOC)
+#include "stack_stats.h"     // pico de pilha por task (projPILHA_MONITOR_MS)
+#include "stress_timers.h"   // modo estresse (projTIMER_STRESS)
 
 /* =======================================================================
  * Exemplo 05 – Uso de Software Timer no FreeRTOS
  * Demonstra como criar timers periódicos e de disparo único.
+ * Com projTIMER_STRESS=1 roda o estresse com 10 a 1000 timers (stress_timers.c).
  * ======================================================================= */
 
 /* Handles dos timers */
 TimerHandle_t xTimerBlink;
 TimerHandle_t xTimerOneShot;
 
+/* Buffers do modo estático (projSTATIC_ALLOC=1) */
+#if ( projSTATIC_ALLOC == 1 )
+static StaticTimer_t xTimerBlinkBuf, xTimerOneShotBuf;
+#endif
+
 /* ---------- Callback do timer periódico ---------- */
 void vTimerBlinkCallback(TimerHandle_t xTimer)
 {
@@ -75,6 +86,7 @@ void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer,
 void vApplicationDaemonTaskStartupHook(void)
 {
     printf("[DaemonTask] Serviço de timers iniciado.\n");
+    vBootRelatorio();   // RAM dos objetos e tempo até o escalonador
 }
 
 /* =======================================================================
@@ -82,21 +94,33 @@ void vApplicationDaemonTaskStartupHook(void)
  * ======================================================================= */
 int main(void)
 {
+    /* heap_5: as regiões precisam existir antes da primeira alocação */
+    vHeapIniciar();
+    vBootInicio();
+
+#if ( projTIMER_STRESS == 1 )
+    printf("=== FreeRTOS: Exemplo 05 – Estresse de Software Timers ===\n");
+
+    /* N timers com períodos sorteados: atraso, carga da daemon e fila de comandos */
+    vStressTimersIniciar();
+#else
     printf("=== FreeRTOS: Exemplo 05 – Software Timer ===\n");
 
     /* Cria um timer periódico (LED piscando a cada 1 s) */
-    xTimerBlink = xTimerCreate("TimerBlink",
-                               pdMS_TO_TICKS(1000),   // período: 1 s
-                               pdTRUE,                // pdTRUE → periódico
-                               NULL,
-                               vTimerBlinkCallback);
+    xTimerBlink = xBootTimer("TimerBlink",
+                             pdMS_TO_TICKS(1000),   // período: 1 s
+                             pdTRUE,                // pdTRUE → periódico
+                             NULL,
+                             vTimerBlinkCallback,
+                             BOOT_ESTATICO(&xTimerBlinkBuf));
 
     /* Cria um timer de disparo único (executa após 5 s) */
-    xTimerOneShot = xTimerCreate("TimerOneShot",
-                                 pdMS_TO_TICKS(5000), // atraso: 5 s
-                                 pdFALSE,              // pdFALSE → uma vez só
-                                 NULL,
-                                 vTimerOneShotCallback);
+    xTimerOneShot = xBootTimer("TimerOneShot",
+                               pdMS_TO_TICKS(5000), // atraso: 5 s
+                               pdFALSE,              // pdFALSE → uma vez só
+                               NULL,
+                               vTimerOneShotCallback,
+                               BOOT_ESTATICO(&xTimerOneShotBuf));
 
     if (xTimerBlink == NULL || xTimerOneShot == NULL)
     {
@@ -108,6 +132,13 @@ int main(void)
     xTimerStart(xTimerBlink, 0);
     xTimerStart(xTimerOneShot, 0);
 
+    /* Tabela periódica de CPU% por task */
+    vEstatIniciarMonitor(projRUNTIME_MONITOR_MS);
+#endif /* projTIMER_STRESS */
+
+    /* Pico de pilha por task e tamanho sugerido (0 = desliga) */
+    vPilhaIniciar(projPILHA_MONITOR_MS);
+
     /* Inicia o escalonador */
     vTaskStartScheduler();
 
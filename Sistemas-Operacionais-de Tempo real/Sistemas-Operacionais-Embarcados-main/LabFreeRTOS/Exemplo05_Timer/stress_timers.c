@@ -0,0 +1,320 @@
+#include <stdio.h>
+#include <stdlib.h>   // exit
+#include <time.h>     // clock_gettime (port POSIX)
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "runtime_stats.h"
+#include "heap_stats.h"   // projHEAP
+#include "boot_stats.h"   // xBootTask, projPILHA_TASK
+#include "stress_timers.h"
+
+/* Cada fase cria e apaga até 1000 timers; no heap_1 o vPortFree dá assert. */
+#if ( projTIMER_STRESS == 1 ) && ( projHEAP == 1 )
+    #error "projTIMER_STRESS precisa liberar memória: use HEAP=2, 3, 4 ou 5"
+#endif
+
+/* =======================================================================
+ * Estresse de software timers
+ * Cada timer guarda no seu ID (pvTimerGetTimerID) o instante ideal do
+ * próximo disparo, em ticks e em µs. O atraso em ticks mostra a daemon
+ * atrasando (callbacks na fila atrás de outros); o atraso em µs inclui
+ * também a quantização do tick. Os agregados são atualizados só pela
+ * daemon e lidos pelo controle com os timers já apagados.
+ * ======================================================================= */
+
+typedef enum { E_INLINE, E_PEND, E_WORKER, N_ESTRATEGIAS } Estrategia;
+
+static const char * const pcEstrategias[N_ESTRATEGIAS] = { "inline", "pend", "worker" };
+static const uint32_t ulNs[] = { 10, 30, 100, 300, 1000 };
+#define N_CASOS      (sizeof(ulNs) / sizeof(ulNs[0]))
+#define N_MAX        1000
+#define FILA_WORKER  64
+
+typedef struct
+{
+    TickType_t xPeriodo;
+    TickType_t xEsperadoTick;     /* próximo disparo ideal */
+    uint64_t ullBaseUs;           /* instante do start */
+    uint32_t ulDisparos;
+    int iPesado;
+} EstTimer;
+
+typedef struct
+{
+    uint32_t ulCallbacks;
+    uint32_t ulAtrasados;         /* disparou depois do tick agendado */
+    uint32_t ulAtrasoMaxTicks;
+    int64_t llSomaUs;
+    int64_t llMaxUs;
+    uint32_t ulFalhasFila;        /* pend ou worker: não coube na fila */
+} Agregado;
+
+static TimerHandle_t xTimers[N_MAX];
+static EstTimer xEst[N_MAX];
+static Agregado xAg;
+static Estrategia eEstrategia;
+static QueueHandle_t xFilaWorker;
+static TaskHandle_t xWorker;
+
+#if ( projSTATIC_ALLOC == 1 )
+static StaticTask_t xTcbControle, xTcbWorker;
+static StackType_t uxPilhaControle[projPILHA_TASK], uxPilhaWorker[projPILHA_TASK];
+#endif
+
+/* ---------- Trabalho pesado ---------- */
+
+/* Gasta CPU de verdade (relógio da thread: não conta o tempo preemptada). */
+static void vTrabalhoPesado(void)
+{
+    struct timespec a, b;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &a);
+    do
+    {
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &b);
+    } while ((b.tv_sec - a.tv_sec) * 1000000000LL + (b.tv_nsec - a.tv_nsec) <
+             projSTRESS_PESADO_US * 1000LL);
+}
+
+/* Assinatura de PendedFunction_t. */
+static void vPesadoAdiado(void *pvParametro1, uint32_t ulParametro2)
+{
+    (void) pvParametro1;
+    (void) ulParametro2;
+    vTrabalhoPesado();
+}
+
+static void vTaskWorker(void *pvParameters)
+{
+    (void) pvParameters;
+    EstTimer *e;
+
+    for (;;)
+    {
+        xQueueReceive(xFilaWorker, &e, portMAX_DELAY);
+        vTrabalhoPesado();
+    }
+}
+
+/* ---------- Callback (roda na daemon) ---------- */
+
+static void vCallbackStress(TimerHandle_t xTimer)
+{
+    const uint64_t ullAgora = ulGetRunTimeCounterValue();
+    const TickType_t xAgora = xTaskGetTickCount();
+    EstTimer *e = (EstTimer *) pvTimerGetTimerID(xTimer);
+
+    e->ulDisparos++;
+    int32_t lAtrasoTicks = (int32_t) (xAgora - e->xEsperadoTick);
+    int64_t llAtrasoUs = (int64_t) (ullAgora - e->ullBaseUs) -
+                         (int64_t) e->ulDisparos * e->xPeriodo * portTICK_PERIOD_MS * 1000;
+    e->xEsperadoTick += e->xPeriodo;
+
+    xAg.ulCallbacks++;
+    xAg.llSomaUs += llAtrasoUs;
+    if (llAtrasoUs > xAg.llMaxUs)
+    {
+        xAg.llMaxUs = llAtrasoUs;
+    }
+    if (lAtrasoTicks > 0)
+    {
+        xAg.ulAtrasados++;
+        if ((uint32_t) lAtrasoTicks > xAg.ulAtrasoMaxTicks)
+        {
+            xAg.ulAtrasoMaxTicks = (uint32_t) lAtrasoTicks;
+        }
+    }
+
+    if (!e->iPesado)
+    {
+        return;
+    }
+
+    switch (eEstrategia)
+    {
+        case E_INLINE:
+            vTrabalhoPesado();
+            break;
+        case E_PEND:
+            /* Vai para a fila de comandos da PRÓPRIA daemon: sem espera. */
+            if (xTimerPendFunctionCall(vPesadoAdiado, e, 0, 0) != pdPASS)
+            {
+                xAg.ulFalhasFila++;
+            }
+            break;
+        case E_WORKER:
+            if (xQueueSend(xFilaWorker, &e, 0) != pdPASS)
+            {
+                xAg.ulFalhasFila++;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* ---------- Controle ---------- */
+
+static uint32_t ulSemente = 12345;
+
+static uint32_t ulSortear(uint32_t ulMin, uint32_t ulMax)
+{
+    ulSemente = ulSemente * 1103515245u + 12345u;   /* LCG: repetível entre execuções */
+    return ulMin + (ulSemente >> 8) % (ulMax - ulMin + 1);
+}
+
+static configRUN_TIME_COUNTER_TYPE ulCpuDe(TaskHandle_t xTask)
+{
+    TaskStatus_t xStatus;
+    vTaskGetInfo(xTask, &xStatus, pdFALSE, eInvalid);
+    return xStatus.ulRunTimeCounter;
+}
+
+/* Cria e dispara n timers; retorna quantos foram criados. */
+static uint32_t ulCriarTimers(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        EstTimer *e = &xEst[i];
+        e->xPeriodo = pdMS_TO_TICKS(ulSortear(projSTRESS_PER_MIN_MS, projSTRESS_PER_MAX_MS));
+        e->ulDisparos = 0;
+        e->iPesado = (i % projSTRESS_PESADO_CADA) == 0;
+
+        xTimers[i] = xTimerCreate("Stress", e->xPeriodo, pdTRUE, e, vCallbackStress);
+        if (xTimers[i] == NULL)
+        {
+            return i;
+        }
+
+        /* O start leva o tick atual: é a referência da daemon para o 1º disparo. */
+        e->xEsperadoTick = xTaskGetTickCount() + e->xPeriodo;
+        e->ullBaseUs = ulGetRunTimeCounterValue();
+        xTimerStart(xTimers[i], portMAX_DELAY);
+    }
+    return n;
+}
+
+static void vApagarTimers(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        xTimerDelete(xTimers[i], portMAX_DELAY);
+    }
+}
+
+/* Rajada de resets com a prioridade da daemon (como uma ISR ou task
+ * crítica): a daemon não preempta quem envia e a fila enche. */
+static uint32_t ulRajada(uint32_t n)
+{
+    UBaseType_t uxPrio = uxTaskPriorityGet(NULL);
+    uint32_t ulRecusados = 0;
+
+    vTaskPrioritySet(NULL, configTIMER_TASK_PRIORITY);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (xTimerReset(xTimers[i], 0) != pdPASS)
+        {
+            ulRecusados++;
+        }
+    }
+    vTaskPrioritySet(NULL, uxPrio);
+    return ulRecusados;
+}
+
+static void vTaskControle(void *pvParameters)
+{
+    (void) pvParameters;
+    TaskHandle_t xDaemon = xTimerGetTimerDaemonTaskHandle();
+
+    printf("\nPeríodos em [%d, %d] ms, 1 timer pesado (%d µs) a cada %d, fases de %d ms, "
+           "fila de comandos = %d\n", projSTRESS_PER_MIN_MS, projSTRESS_PER_MAX_MS,
+           projSTRESS_PESADO_US, projSTRESS_PESADO_CADA, projSTRESS_FASE_MS,
+           configTIMER_QUEUE_LENGTH);
+    printf("%5s %-7s %10s %11s %11s %10s %10s %8s %8s %9s\n", "N", "pesado", "callbacks",
+           "atraso méd", "atraso máx", "atrasados", "máx", "daemon", "worker", "fila");
+    printf("%5s %-7s %10s %11s %11s %10s %10s %8s %8s %9s\n", "", "", "", "(µs)", "(µs)",
+           "(>0 tick)", "(ticks)", "CPU%", "CPU%", "recusou");
+
+    for (size_t c = 0; c < N_CASOS; c++)
+    {
+        const uint32_t n = ulNs[c];
+        uint32_t ulRecusadosRajada = 0;
+
+        for (int s = 0; s < N_ESTRATEGIAS; s++)
+        {
+            eEstrategia = (Estrategia) s;
+            ulSemente = 12345 + n;   /* mesmos períodos nas três estratégias */
+
+            uint32_t ulCriados = ulCriarTimers(n);
+            if (ulCriados < n)
+            {
+                printf("%5lu: só %lu timers criados (memória)\n",
+                       (unsigned long) n, (unsigned long) ulCriados);
+            }
+
+            /* Zera as medidas só depois de todos os starts. */
+            vTaskSuspendAll();
+            xAg = (Agregado) { 0 };
+            xAg.llMaxUs = INT64_MIN;
+            (void) xTaskResumeAll();
+
+            configRUN_TIME_COUNTER_TYPE ulD0 = ulCpuDe(xDaemon), ulW0 = ulCpuDe(xWorker);
+            uint64_t ullT0 = ulGetRunTimeCounterValue();
+
+            vTaskDelay(pdMS_TO_TICKS(projSTRESS_FASE_MS));
+
+            /* Congela o agregado (a daemon roda acima desta task). */
+            vTaskSuspendAll();
+            Agregado xFoto = xAg;
+            configRUN_TIME_COUNTER_TYPE ulD1 = ulCpuDe(xDaemon), ulW1 = ulCpuDe(xWorker);
+            uint64_t ullT1 = ulGetRunTimeCounterValue();
+            (void) xTaskResumeAll();
+
+            if (s == N_ESTRATEGIAS - 1)
+            {
+                ulRecusadosRajada = ulRajada(ulCriados);
+            }
+            vApagarTimers(ulCriados);
+            xQueueReset(xFilaWorker);
+
+            double dJanela = (double) (ullT1 - ullT0);
+            printf("%5lu %-7s %10lu %11.0f %11lld %9.1f%% %10lu %7.1f%% %7.1f%% %9lu\n",
+                   (unsigned long) n, pcEstrategias[s], (unsigned long) xFoto.ulCallbacks,
+                   xFoto.ulCallbacks ? (double) xFoto.llSomaUs / xFoto.ulCallbacks : 0.0,
+                   xFoto.ulCallbacks ? (long long) xFoto.llMaxUs : 0LL,
+                   xFoto.ulCallbacks ? 100.0 * xFoto.ulAtrasados / xFoto.ulCallbacks : 0.0,
+                   (unsigned long) xFoto.ulAtrasoMaxTicks,
+                   100.0 * (ulD1 - ulD0) / dJanela, 100.0 * (ulW1 - ulW0) / dJanela,
+                   (unsigned long) xFoto.ulFalhasFila);
+            fflush(stdout);
+        }
+
+        printf("%5lu rajada de %lu xTimerReset na prioridade da daemon: %lu recusados "
+               "(fila de %d)\n\n", (unsigned long) n, (unsigned long) n,
+               (unsigned long) ulRecusadosRajada, configTIMER_QUEUE_LENGTH);
+    }
+
+    printf("Fim do estresse.\n");
+    fflush(stdout);
+    exit(0);
+}
+
+void vStressTimersIniciar(void)
+{
+    xFilaWorker = xQueueCreate(FILA_WORKER, sizeof(EstTimer *));
+    if (xFilaWorker == NULL)
+    {
+        printf("Falha ao criar fila do worker!\n");
+        return;
+    }
+
+    /* Controle abaixo da daemon (seus comandos são atendidos na hora) e
+     * acima do worker; o worker fica com o que sobrar da CPU. */
+    xBootTask(vTaskControle, "Controle", projPILHA_TASK, NULL, configTIMER_TASK_PRIORITY - 1,
+              BOOT_ESTATICO(uxPilhaControle), BOOT_ESTATICO(&xTcbControle));
+    xWorker = xBootTask(vTaskWorker, "Worker", projPILHA_TASK, NULL, 1,
+                        BOOT_ESTATICO(uxPilhaWorker), BOOT_ESTATICO(&xTcbWorker));
+}
@@ -0,0 +1,40 @@
+/*
+ * stress_timers.h — modo estresse do Exemplo 05 (projTIMER_STRESS=1 no Makefile)
+ *
+ * Para N = 10, 30, 100, 300, 1000 timers periódicos com períodos sorteados,
+ * mede o atraso de cada callback em relação ao instante ideal, a carga da
+ * task daemon e o que acontece com a fila de comandos (configTIMER_QUEUE_LENGTH)
+ * numa rajada de comandos. Um em cada projSTRESS_PESADO_CADA timers faz um
+ * trabalho "pesado", executado de três jeitos:
+ *   inline   dentro do callback (na daemon)
+ *   pend     adiado com xTimerPendFunctionCall (roda na daemon, pela fila de comandos)
+ *   worker   entregue a uma task de prioridade baixa por uma fila
+ */
+
+#ifndef STRESS_TIMERS_H
+#define STRESS_TIMERS_H
+
+#ifndef projTIMER_STRESS
+    #define projTIMER_STRESS    0
+#endif
+
+#ifndef projSTRESS_FASE_MS
+    #define projSTRESS_FASE_MS       3000    /* duração de cada medição */
+#endif
+#ifndef projSTRESS_PER_MIN_MS
+    #define projSTRESS_PER_MIN_MS    10      /* períodos sorteados em [min, max] */
+#endif
+#ifndef projSTRESS_PER_MAX_MS
+    #define projSTRESS_PER_MAX_MS    500
+#endif
+#ifndef projSTRESS_PESADO_CADA
+    #define projSTRESS_PESADO_CADA   10      /* 1 timer pesado a cada 10 */
+#endif
+#ifndef projSTRESS_PESADO_US
+    #define projSTRESS_PESADO_US     1000    /* CPU gasta pelo trabalho pesado */
+#endif
+
+/* Cria a task que roda a tabela toda e encerra o programa no fim. */
+void vStressTimersIniciar(void);
+
+#endif /* STRESS_TIMERS_H */
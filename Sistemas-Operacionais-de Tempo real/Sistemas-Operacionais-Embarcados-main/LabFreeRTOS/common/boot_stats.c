@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <time.h>     // clock_gettime (port POSIX)
+
+#include "boot_stats.h"
+#include "heap_stats.h"
+
+#define BOOT_MAX_TASKS    32
+
+/* ---------- Contagem ---------- */
+
+static uint64_t ullInicioNs;
+static uint64_t ullCreatesNs;
+static uint32_t ulObjetos;
+static size_t xBytes;
+
+/* Pilha de cada task criada aqui (para o stack_stats.c). */
+static TaskHandle_t xTasks[BOOT_MAX_TASKS];
+static uint32_t ulPilhas[BOOT_MAX_TASKS];
+static uint32_t ulTasks;
+
+static inline uint64_t ullAgoraNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/* Soma um objeto criado; t0 = instante antes do create. */
+static void vContar(uint64_t t0, void *pvHandle, size_t xTam)
+{
+    ullCreatesNs += ullAgoraNs() - t0;
+    if (pvHandle != NULL)
+    {
+        ulObjetos++;
+        xBytes += xTam;
+    }
+}
+
+void vBootInicio(void)
+{
+    ullInicioNs = ullAgoraNs();
+}
+
+/* ---------- Creates ---------- */
+
+TaskHandle_t xBootTask(TaskFunction_t pxFuncao, const char *pcNome, uint32_t ulPilha,
+                       void *pvParametro, UBaseType_t uxPrioridade,
+                       StackType_t *puxPilha, StaticTask_t *pxTcb)
+{
+    TaskHandle_t xTask = NULL;
+    const uint64_t t0 = ullAgoraNs();
+
+#if ( projSTATIC_ALLOC == 1 )
+    xTask = xTaskCreateStatic(pxFuncao, pcNome, ulPilha, pvParametro, uxPrioridade,
+                              puxPilha, pxTcb);
+#else
+    (void) puxPilha;
+    (void) pxTcb;
+    if (xTaskCreate(pxFuncao, pcNome, ulPilha, pvParametro, uxPrioridade, &xTask) != pdPASS)
+    {
+        xTask = NULL;
+    }
+#endif
+
+    vContar(t0, xTask, sizeof(StaticTask_t) + ulPilha * sizeof(StackType_t));
+    if (xTask != NULL && ulTasks < BOOT_MAX_TASKS)
+    {
+        xTasks[ulTasks] = xTask;
+        ulPilhas[ulTasks] = ulPilha;
+        ulTasks++;
+    }
+    return xTask;
+}
+
+uint32_t ulBootPilhaDe(TaskHandle_t xTask)
+{
+    for (uint32_t i = 0; i < ulTasks; i++)
+    {
+        if (xTasks[i] == xTask)
+        {
+            return ulPilhas[i];
+        }
+    }
+    return 0;
+}
+
+QueueHandle_t xBootFila(UBaseType_t uxItens, UBaseType_t uxTamItem,
+                        uint8_t *pucArea, StaticQueue_t *pxFila)
+{
+    const uint64_t t0 = ullAgoraNs();
+
+#if ( projSTATIC_ALLOC == 1 )
+    QueueHandle_t xFila = xQueueCreateStatic(uxItens, uxTamItem, pucArea, pxFila);
+#else
+    (void) pucArea;
+    (void) pxFila;
+    QueueHandle_t xFila = xQueueCreate(uxItens, uxTamItem);
+#endif
+
+    vContar(t0, xFila, sizeof(StaticQueue_t) + (size_t) uxItens * uxTamItem);
+    return xFila;
+}
+
+SemaphoreHandle_t xBootMutex(StaticSemaphore_t *pxSemaforo)
+{
+    const uint64_t t0 = ullAgoraNs();
+
+#if ( projSTATIC_ALLOC == 1 )
+    SemaphoreHandle_t xSemaforo = xSemaphoreCreateMutexStatic(pxSemaforo);
+#else
+    (void) pxSemaforo;
+    SemaphoreHandle_t xSemaforo = xSemaphoreCreateMutex();
+#endif
+
+    vContar(t0, xSemaforo, sizeof(StaticSemaphore_t));
+    return xSemaforo;
+}
+
+SemaphoreHandle_t xBootBinario(StaticSemaphore_t *pxSemaforo)
+{
+    const uint64_t t0 = ullAgoraNs();
+
+#if ( projSTATIC_ALLOC == 1 )
+    SemaphoreHandle_t xSemaforo = xSemaphoreCreateBinaryStatic(pxSemaforo);
+#else
+    (void) pxSemaforo;
+    SemaphoreHandle_t xSemaforo = xSemaphoreCreateBinary();
+#endif
+
+    vContar(t0, xSemaforo, sizeof(StaticSemaphore_t));
+    return xSemaforo;
+}
+
+TimerHandle_t xBootTimer(const char *pcNome, TickType_t xPeriodo, UBaseType_t uxRecarga,
+                         void *pvId, TimerCallbackFunction_t pxCallback,
+                         StaticTimer_t *pxTimer)
+{
+    const uint64_t t0 = ullAgoraNs();
+
+#if ( projSTATIC_ALLOC == 1 )
+    TimerHandle_t xTimer = xTimerCreateStatic(pcNome, xPeriodo, uxRecarga, pvId, pxCallback,
+                                              pxTimer);
+#else
+    (void) pxTimer;
+    TimerHandle_t xTimer = xTimerCreate(pcNome, xPeriodo, uxRecarga, pvId, pxCallback);
+#endif
+
+    vContar(t0, xTimer, sizeof(StaticTimer_t));
+    return xTimer;
+}
+
+/* ---------- Relatório ---------- */
+
+void vBootRelatorio(void)
+{
+    static int iImpresso = 0;
+    const uint64_t ullAteEscalonador = ullAgoraNs() - ullInicioNs;
+    HeapAmostra x;
+
+    if (iImpresso)
+    {
+        return;
+    }
+    iImpresso = 1;
+
+    printf("\n--- Boot (%s) ---\n", projSTATIC_ALLOC ? "alocação estática" : "alocação dinâmica");
+    printf("Objetos: %lu, RAM %lu B (%s)\n", (unsigned long) ulObjetos, (unsigned long) xBytes,
+           projSTATIC_ALLOC ? "vetores static, fora do heap" :
+                              "pedidos ao heap, sem cabeçalho dos blocos");
+    printf("Tempo nos creates: %.1f µs; main → escalonador rodando: %.1f µs\n",
+           ullCreatesNs / 1e3, ullAteEscalonador / 1e3);
+
+    vHeapAmostrar(&x);
+    if (x.xLivre != HEAP_NAO_INFORMA)
+    {
+        /* O heap_4 só se inicializa na primeira alocação: antes dela "livre" é 0. */
+        const size_t xOcupado = (x.xAlocacoes == 0) ? 0 : configTOTAL_HEAP_SIZE - x.xLivre;
+        printf("Heap ocupado (heap_%d): %lu B de %lu B\n", projHEAP,
+               (unsigned long) xOcupado, (unsigned long) configTOTAL_HEAP_SIZE);
+    }
+    printf("\n");
+    fflush(stdout);
+}
@@ -0,0 +1,84 @@
+/*
+ * boot_stats.h — objetos do boot em RAM estática ou no heap (projSTATIC_ALLOC)
+ *
+ * Os exemplos criam suas tasks, filas, semáforos e timers por estas funções:
+ *   projSTATIC_ALLOC=0  xTaskCreate, xQueueCreate, ... (heap do FreeRTOS)
+ *   projSTATIC_ALLOC=1  xTaskCreateStatic, xQueueCreateStatic, ... com os
+ *                       buffers passados por quem chama (vetores static do
+ *                       main.c: o tamanho aparece no mapa do linker)
+ * Os buffers vão por BOOT_ESTATICO(x), que vira NULL no modo dinâmico — os
+ * vetores só precisam existir quando projSTATIC_ALLOC=1.
+ *
+ * Cada create soma a RAM do objeto (TCB + pilha, estrutura + área da fila,
+ * ...) e o tempo da chamada. vBootRelatorio(), no
+ * vApplicationDaemonTaskStartupHook (primeira coisa que roda depois do
+ * vTaskStartScheduler), imprime: objetos, RAM, tempo nos creates, tempo do
+ * main até o escalonador e quanto do heap ficou ocupado (heap_1/2/4/5).
+ *
+ * Uso:
+ *   vBootInicio();                                  // início do main
+ *   xBootTask(vTaskA, "TaskA", projPILHA_TASK, NULL, 2,
+ *             BOOT_ESTATICO(uxPilhaA), BOOT_ESTATICO(&xTcbA));
+ *   vBootRelatorio();                               // no DaemonTaskStartupHook
+ */
+
+#ifndef BOOT_STATS_H
+#define BOOT_STATS_H
+
+#include <limits.h>   // PTHREAD_STACK_MIN
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+
+#ifndef projSTATIC_ALLOC
+    #define projSTATIC_ALLOC    0
+#endif
+
+#if ( projSTATIC_ALLOC == 1 )
+    #define BOOT_ESTATICO( x )    ( x )
+#else
+    #define BOOT_ESTATICO( x )    NULL
+#endif
+
+/* Menor pilha que o port POSIX consegue entregar ao pthread. O
+ * pxPortInitialiseStack guarda o Thread_t no topo do vetor e passa ao
+ * pthread_attr_setstack só o que sobra abaixo dele: com um vetor de
+ * exatamente PTHREAD_STACK_MIN bytes sobra menos que isso, a chamada falha
+ * (EINVAL) e a task roda na pilha padrão da libc — o vetor reservado nem é
+ * usado e a marca d'água não mede nada. A folga cobre o Thread_t (5
+ * palavras) e o alinhamento do topo. Numa MCU o piso é o que o Monitor mede. */
+#define BOOT_PILHA_FOLGA    64
+#define BOOT_PILHA_MIN      ( PTHREAD_STACK_MIN / sizeof( StackType_t ) + BOOT_PILHA_FOLGA )
+
+/* Pilha (palavras) das tasks dos exemplos. */
+#ifndef projPILHA_TASK
+    #define projPILHA_TASK    BOOT_PILHA_MIN
+#endif
+
+/* Marca o início do boot (primeira linha do main). */
+void vBootInicio(void);
+
+TaskHandle_t xBootTask(TaskFunction_t pxFuncao, const char *pcNome, uint32_t ulPilha,
+                       void *pvParametro, UBaseType_t uxPrioridade,
+                       StackType_t *puxPilha, StaticTask_t *pxTcb);
+
+QueueHandle_t xBootFila(UBaseType_t uxItens, UBaseType_t uxTamItem,
+                        uint8_t *pucArea, StaticQueue_t *pxFila);
+
+SemaphoreHandle_t xBootMutex(StaticSemaphore_t *pxSemaforo);
+SemaphoreHandle_t xBootBinario(StaticSemaphore_t *pxSemaforo);
+
+TimerHandle_t xBootTimer(const char *pcNome, TickType_t xPeriodo, UBaseType_t uxRecarga,
+                         void *pvId, TimerCallbackFunction_t pxCallback,
+                         StaticTimer_t *pxTimer);
+
+/* Pilha (palavras) com que a task foi criada por xBootTask; 0 se não foi. */
+uint32_t ulBootPilhaDe(TaskHandle_t xTask);
+
+/* Imprime o resumo do boot (só na primeira chamada). */
+void vBootRelatorio(void);
+
+#endif /* BOOT_STATS_H */
@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>   // exit
+#include <time.h>     // clock_gettime (port POSIX)
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "message_buffer.h"
+#include "heap_stats.h"
+#include "boot_stats.h"   // xBootTask, projPILHA_TASK
+
+/* =======================================================================
+ * Benchmark de alocação (projHEAP_BENCH = 1)
+ * A cada passo um slot é sorteado: vazio → cria um objeto de tipo e
+ * tamanho sorteados; ocupado → apaga o que estiver lá. Em regime fica
+ * metade dos slots ocupados, com tamanhos misturados — o padrão que
+ * fragmenta um heap de firmware que roda meses. Cada create/delete é
+ * cronometrado; a cada projHEAP_AMOSTRA_MS sai uma linha com o estado
+ * do heap. No heap_1 nada é liberado: o teste só aloca até esgotar.
+ * O apagar de um timer é um comando para a daemon (prioridade maior),
+ * então a latência dele inclui a troca de contexto até ela.
+ * ======================================================================= */
+
+typedef enum { T_FILA, T_TIMER, T_MSGBUF, T_BLOCO, N_TIPOS } Tipo;
+
+static const char * const pcTipos[N_TIPOS] = { "fila", "timer", "msgbuf", "bloco" };
+
+#define PODE_LIBERAR    ( projHEAP != 1 )
+
+typedef struct
+{
+    void *pv;               /* NULL = slot vazio */
+    Tipo eTipo;
+} Slot;
+
+typedef struct
+{
+    uint32_t ulOps;
+    uint32_t ulFalhas;
+    uint64_t ullSomaNs;
+    uint32_t ulMaxNs;
+} Lat;
+
+static Slot xSlots[projHEAP_BENCH_SLOTS];
+static Lat xAlocTipo[N_TIPOS], xFreeTipo[N_TIPOS];   /* totais por tipo */
+static Lat xAlocJanela, xFreeJanela;                 /* desde a última amostra */
+
+static inline uint64_t ullAgoraNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static void vSomar(Lat *px, uint32_t ulNs, int iFalhou)
+{
+    px->ulOps++;
+    px->ulFalhas += iFalhou ? 1 : 0;
+    px->ullSomaNs += ulNs;
+    if (ulNs > px->ulMaxNs)
+    {
+        px->ulMaxNs = ulNs;
+    }
+}
+
+static uint32_t ulSemente = 12345;
+
+static uint32_t ulSortear(uint32_t ulMin, uint32_t ulMax)
+{
+    ulSemente = ulSemente * 1103515245u + 12345u;   /* LCG: repetível entre execuções */
+    return ulMin + (ulSemente >> 8) % (ulMax - ulMin + 1);
+}
+
+/* ---------- Objetos ---------- */
+
+static void vTimerVazio(TimerHandle_t xTimer)
+{
+    (void) xTimer;   /* nunca é disparado: só ocupa memória */
+}
+
+static void *pvCriar(Tipo eTipo)
+{
+    switch (eTipo)
+    {
+        case T_FILA:
+            return xQueueCreate(ulSortear(1, 16), ulSortear(4, 64));
+        case T_TIMER:
+            return xTimerCreate("Heap", 1000, pdFALSE, NULL, vTimerVazio);
+        case T_MSGBUF:
+            return xMessageBufferCreate(ulSortear(64, 2048));
+        case T_BLOCO:
+            return pvPortMalloc(ulSortear(16, 4096));
+        default:
+            return NULL;
+    }
+}
+
+static void vApagar(Tipo eTipo, void *pv)
+{
+    switch (eTipo)
+    {
+        case T_FILA:
+            vQueueDelete((QueueHandle_t) pv);
+            break;
+        case T_TIMER:
+            xTimerDelete((TimerHandle_t) pv, portMAX_DELAY);
+            break;
+        case T_MSGBUF:
+            vMessageBufferDelete((MessageBufferHandle_t) pv);
+            break;
+        case T_BLOCO:
+            vPortFree(pv);
+            break;
+        default:
+            break;
+    }
+}
+
+/* ---------- Relatório ---------- */
+
+static void vImprimirTam(size_t xValor)
+{
+    if (xValor == HEAP_NAO_INFORMA)
+    {
+        printf(" %9s", "-");
+    }
+    else
+    {
+        printf(" %9lu", (unsigned long) xValor);
+    }
+}
+
+static void vImprimirAmostra(double dSeg, uint32_t ulVivos)
+{
+    HeapAmostra x;
+
+    vHeapAmostrar(&x);
+    printf("%6.1f %6lu", dSeg, (unsigned long) ulVivos);
+    vImprimirTam(x.xLivre);
+    vImprimirTam(x.xMinimo);
+    vImprimirTam(x.xMaiorBloco);
+    vImprimirTam(x.xBlocosLivres);
+    if (x.xMaiorBloco != HEAP_NAO_INFORMA && x.xLivre > 0)
+    {
+        printf(" %6.1f%%", 100.0 * (1.0 - (double) x.xMaiorBloco / x.xLivre));
+    }
+    else
+    {
+        printf(" %7s", "-");
+    }
+    printf(" %7lu %8.0f %8lu %8.0f %8lu\n", (unsigned long) xAlocJanela.ulFalhas,
+           xAlocJanela.ulOps ? (double) xAlocJanela.ullSomaNs / xAlocJanela.ulOps : 0.0,
+           (unsigned long) xAlocJanela.ulMaxNs,
+           xFreeJanela.ulOps ? (double) xFreeJanela.ullSomaNs / xFreeJanela.ulOps : 0.0,
+           (unsigned long) xFreeJanela.ulMaxNs);
+    fflush(stdout);
+
+    xAlocJanela = (Lat) { 0 };
+    xFreeJanela = (Lat) { 0 };
+}
+
+static void vImprimirTotais(void)
+{
+    printf("\n%-8s %9s %7s %9s %9s %9s %9s\n", "Tipo", "creates", "falhas", "aloc méd",
+           "aloc máx", "free méd", "free máx");
+    printf("%-8s %9s %7s %9s %9s %9s %9s\n", "", "", "", "(ns)", "(ns)", "(ns)", "(ns)");
+    for (int t = 0; t < N_TIPOS; t++)
+    {
+        Lat *a = &xAlocTipo[t], *f = &xFreeTipo[t];
+        printf("%-8s %9lu %7lu %9.0f %9lu %9.0f %9lu\n", pcTipos[t],
+               (unsigned long) a->ulOps, (unsigned long) a->ulFalhas,
+               a->ulOps ? (double) a->ullSomaNs / a->ulOps : 0.0, (unsigned long) a->ulMaxNs,
+               f->ulOps ? (double) f->ullSomaNs / f->ulOps : 0.0, (unsigned long) f->ulMaxNs);
+    }
+}
+
+/* ---------- Task do benchmark ---------- */
+
+#if ( projSTATIC_ALLOC == 1 )
+static StaticTask_t xTcbHeapBench;
+static StackType_t uxPilhaHeapBench[projPILHA_TASK];
+#endif
+
+static void vTaskHeapBench(void *pvParameters)
+{
+    (void) pvParameters;
+    const uint64_t ullInicio = ullAgoraNs();
+    const uint64_t ullFim = ullInicio + projHEAP_BENCH_S * 1000000000ULL;
+    uint64_t ullProxima = ullInicio + projHEAP_AMOSTRA_MS * 1000000ULL;
+    uint32_t ulVivos = 0;
+
+    printf("\nheap_%d, %lu B; %d slots, objetos: fila (1-16 x 4-64 B), timer, "
+           "msgbuf (64-2048 B), bloco (16-4096 B)\n", projHEAP,
+           (unsigned long) configTOTAL_HEAP_SIZE, projHEAP_BENCH_SLOTS);
+    printf("%6s %6s %9s %9s %9s %9s %7s %7s %8s %8s %8s %8s\n", "t", "vivos", "livre",
+           "mínimo", "maior", "blocos", "frag", "falhas", "aloc méd", "aloc máx",
+           "free méd", "free máx");
+    printf("%6s %6s %9s %9s %9s %9s %7s %7s %8s %8s %8s %8s\n", "(s)", "", "(B)", "(B)",
+           "bloco(B)", "livres", "", "", "(ns)", "(ns)", "(ns)", "(ns)");
+    vImprimirAmostra(0.0, 0);
+
+    while (ullAgoraNs() < ullFim)
+    {
+        Slot *s = &xSlots[ulSortear(0, projHEAP_BENCH_SLOTS - 1)];
+
+        if (s->pv == NULL)
+        {
+            const Tipo eTipo = (Tipo) ulSortear(0, N_TIPOS - 1);
+            const uint64_t t0 = ullAgoraNs();
+            s->pv = pvCriar(eTipo);
+            const uint32_t ulNs = (uint32_t) (ullAgoraNs() - t0);
+
+            vSomar(&xAlocTipo[eTipo], ulNs, s->pv == NULL);
+            vSomar(&xAlocJanela, ulNs, s->pv == NULL);
+            if (s->pv != NULL)
+            {
+                s->eTipo = eTipo;
+                ulVivos++;
+            }
+            else if (!PODE_LIBERAR)
+            {
+                printf("heap_1 esgotado com %lu objetos vivos (nada é liberado)\n",
+                       (unsigned long) ulVivos);
+                break;
+            }
+        }
+        else if (PODE_LIBERAR)
+        {
+            const uint64_t t0 = ullAgoraNs();
+            vApagar(s->eTipo, s->pv);
+            const uint32_t ulNs = (uint32_t) (ullAgoraNs() - t0);
+
+            vSomar(&xFreeTipo[s->eTipo], ulNs, 0);
+            vSomar(&xFreeJanela, ulNs, 0);
+            s->pv = NULL;
+            ulVivos--;
+        }
+        else if (ulVivos == projHEAP_BENCH_SLOTS)
+        {
+            printf("heap_1: todos os %d slots ocupados\n", projHEAP_BENCH_SLOTS);
+            break;
+        }
+
+        if (ullAgoraNs() >= ullProxima)
+        {
+            vImprimirAmostra((ullProxima - ullInicio) / 1e9, ulVivos);
+            ullProxima += projHEAP_AMOSTRA_MS * 1000000ULL;
+        }
+    }
+
+    vImprimirAmostra((ullAgoraNs() - ullInicio) / 1e9, ulVivos);
+    vImprimirTotais();
+    printf("Fim do benchmark de heap.\n");
+    fflush(stdout);
+    exit(0);
+}
+
+void vHeapBenchIniciar(void)
+{
+    /* Abaixo da daemon de timers: os xTimerDelete são atendidos na hora. */
+    xBootTask(vTaskHeapBench, "HeapBench", projPILHA_TASK, NULL, 2,
+              BOOT_ESTATICO(uxPilhaHeapBench), BOOT_ESTATICO(&xTcbHeapBench));
+}
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_stats.h"
+
+/* ---------- Regiões do heap_5 ---------- */
+
+#if ( projHEAP == 5 )
+
+/* Dois vetores separados fazem o papel de duas RAMs da placa (ex.: SRAM
+ * interna + externa). Somados dão configTOTAL_HEAP_SIZE. */
+#define TAM_REGIAO_A    ( configTOTAL_HEAP_SIZE / 4 )
+#define TAM_REGIAO_B    ( configTOTAL_HEAP_SIZE - TAM_REGIAO_A )
+
+static uint8_t ucRegiaoA[TAM_REGIAO_A];
+static uint8_t ucRegiaoB[TAM_REGIAO_B];
+
+void vHeapIniciar(void)
+{
+    /* vPortDefineHeapRegions exige as regiões em ordem crescente de endereço,
+     * e quem decide onde cada vetor fica é o linker. */
+    const int iAPrimeiro = (uintptr_t) ucRegiaoA < (uintptr_t) ucRegiaoB;
+    HeapRegion_t xRegioes[] =
+    {
+        { iAPrimeiro ? ucRegiaoA : ucRegiaoB, iAPrimeiro ? TAM_REGIAO_A : TAM_REGIAO_B },
+        { iAPrimeiro ? ucRegiaoB : ucRegiaoA, iAPrimeiro ? TAM_REGIAO_B : TAM_REGIAO_A },
+        { NULL, 0 }
+    };
+
+    vPortDefineHeapRegions(xRegioes);
+}
+
+#else
+
+void vHeapIniciar(void)
+{
+}
+
+#endif /* projHEAP == 5 */
+
+/* ---------- Amostra ---------- */
+
+void vHeapAmostrar(HeapAmostra *pxAmostra)
+{
+#if ( projHEAP == 4 ) || ( projHEAP == 5 )
+    HeapStats_t xStats;
+
+    vPortGetHeapStats(&xStats);
+    pxAmostra->xLivre = xStats.xAvailableHeapSpaceInBytes;
+    pxAmostra->xMinimo = xStats.xMinimumEverFreeBytesRemaining;
+    pxAmostra->xMaiorBloco = xStats.xSizeOfLargestFreeBlockInBytes;
+    pxAmostra->xBlocosLivres = xStats.xNumberOfFreeBlocks;
+    pxAmostra->xAlocacoes = xStats.xNumberOfSuccessfulAllocations;
+#elif ( projHEAP == 1 ) || ( projHEAP == 2 )
+    /* Só há xPortGetFreeHeapSize: o mínimo é o menor valor já amostrado. */
+    static size_t xMinimoVisto = HEAP_NAO_INFORMA;
+
+    pxAmostra->xLivre = xPortGetFreeHeapSize();
+    if (pxAmostra->xLivre < xMinimoVisto)
+    {
+        xMinimoVisto = pxAmostra->xLivre;
+    }
+    pxAmostra->xMinimo = xMinimoVisto;
+    pxAmostra->xMaiorBloco = HEAP_NAO_INFORMA;
+    pxAmostra->xBlocosLivres = HEAP_NAO_INFORMA;
+    pxAmostra->xAlocacoes = HEAP_NAO_INFORMA;
+#else
+    /* heap_3: quem sabe do heap é a libc. */
+    pxAmostra->xLivre = HEAP_NAO_INFORMA;
+    pxAmostra->xMinimo = HEAP_NAO_INFORMA;
+    pxAmostra->xMaiorBloco = HEAP_NAO_INFORMA;
+    pxAmostra->xBlocosLivres = HEAP_NAO_INFORMA;
+    pxAmostra->xAlocacoes = HEAP_NAO_INFORMA;
+#endif
+}
+
+/* ---------- Linha do monitor ---------- */
+
+static void vImprimirCampo(const char *pcNome, size_t xValor)
+{
+    if (xValor == HEAP_NAO_INFORMA)
+    {
+        printf("  %s -", pcNome);
+    }
+    else
+    {
+        printf("  %s %lu B", pcNome, (unsigned long) xValor);
+    }
+}
+
+void vHeapImprimir(void)
+{
+    HeapAmostra x;
+
+    vHeapAmostrar(&x);
+    printf("Heap: heap_%d de %lu B", projHEAP, (unsigned long) configTOTAL_HEAP_SIZE);
+    if (projHEAP == 3)
+    {
+        printf(" (não usado: malloc da libc)\n");
+        return;
+    }
+
+    vImprimirCampo("livre", x.xLivre);
+    vImprimirCampo("mínimo", x.xMinimo);
+    vImprimirCampo("maior bloco", x.xMaiorBloco);
+    if (x.xMaiorBloco != HEAP_NAO_INFORMA && x.xLivre > 0)
+    {
+        /* Fragmentação: parte do livre que não serve para a maior alocação. */
+        printf("  frag %.1f%%", 100.0 * (1.0 - (double) x.xMaiorBloco / x.xLivre));
+    }
+    printf("\n");
+}
@@ -0,0 +1,72 @@
+/*
+ * heap_stats.h — esquema de heap do FreeRTOS escolhido no Makefile (make HEAP=n)
+ *
+ * O kernel aloca tudo (TCB, pilha, filas, timers, buffers) por pvPortMalloc,
+ * implementado por UM dos arquivos MemMang/heap_n.c:
+ *   1  só aloca, nunca libera (vPortFree dá assert); determinístico
+ *   2  libera, mas não junta blocos vizinhos: fragmenta com tamanhos variados
+ *   3  malloc/free da libc — ignora configTOTAL_HEAP_SIZE e não tem estatística
+ *   4  first fit com junção de blocos livres vizinhos
+ *   5  igual ao 4, em várias regiões não contíguas (vPortDefineHeapRegions)
+ * O Makefile passa -DprojHEAP=n; o tamanho vem de projHEAP_KB (FreeRTOSConfig.h).
+ *
+ * Uso:
+ *   vHeapIniciar();    // primeira linha do main: heap_5 precisa das regiões
+ *                      // definidas antes de qualquer alocação
+ *   vHeapImprimir();   // uma linha: livre, mínimo histórico, maior bloco
+ *                      // (vEstatImprimir já chama no fim da tabela)
+ *
+ * O benchmark de alocação (heap_bench.c, projHEAP_BENCH=1) cria e apaga
+ * filas, timers, message buffers e blocos crus de tamanhos sorteados e
+ * imprime latência e fragmentação ao longo do tempo.
+ */
+
+#ifndef HEAP_STATS_H
+#define HEAP_STATS_H
+
+#include <stddef.h>
+
+#ifndef projHEAP
+    #define projHEAP    3
+#endif
+
+#ifndef projHEAP_BENCH
+    #define projHEAP_BENCH    0
+#endif
+
+/* Benchmark: duração, período das amostras e quantos objetos vivos no máximo. */
+#ifndef projHEAP_BENCH_S
+    #define projHEAP_BENCH_S         30
+#endif
+#ifndef projHEAP_AMOSTRA_MS
+    #define projHEAP_AMOSTRA_MS      2000
+#endif
+#ifndef projHEAP_BENCH_SLOTS
+    #define projHEAP_BENCH_SLOTS     512
+#endif
+
+/* Valor de campo que o esquema não informa (heap_3; maior bloco no 1 e no 2). */
+#define HEAP_NAO_INFORMA    ( ( size_t ) -1 )
+
+typedef struct
+{
+    size_t xLivre;          /* bytes livres agora */
+    size_t xMinimo;         /* menor valor de xLivre desde o boot */
+    size_t xMaiorBloco;     /* maior alocação que ainda cabe */
+    size_t xBlocosLivres;
+    size_t xAlocacoes;      /* pvPortMalloc bem-sucedidos desde o boot */
+} HeapAmostra;
+
+/* Define as regiões do heap_5 (nos outros esquemas não faz nada). */
+void vHeapIniciar(void);
+
+/* Lê o estado do heap; campos não informados valem HEAP_NAO_INFORMA. */
+void vHeapAmostrar(HeapAmostra *pxAmostra);
+
+/* Imprime uma linha com a amostra atual. */
+void vHeapImprimir(void);
+
+/* Cria a task do benchmark de alocação; o programa termina no fim da tabela. */
+void vHeapBenchIniciar(void);
+
+#endif /* HEAP_STATS_H */
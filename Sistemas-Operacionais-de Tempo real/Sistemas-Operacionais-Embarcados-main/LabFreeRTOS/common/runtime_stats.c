@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <time.h>     // clock_gettime (port POSIX)
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "runtime_stats.h"
+#include "heap_stats.h"
+#include "boot_stats.h"
+
+#define MAX_TASKS_MONITOR    32
+
+/* ---------- Contador de tempo de execução ---------- */
+
+static struct timespec xBase;
+static int xBaseIniciada = 0;
+
+void vConfigureTimerForRunTimeStats(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &xBase);
+    xBaseIniciada = 1;
+}
+
+/* Chamado pelo kernel a cada troca de contexto: precisa ser barato. */
+unsigned long ulGetRunTimeCounterValue(void)
+{
+    struct timespec ts;
+
+    if (!xBaseIniciada)
+    {
+        vConfigureTimerForRunTimeStats();
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long) ((ts.tv_sec - xBase.tv_sec) * 1000000L +
+                            (ts.tv_nsec - xBase.tv_nsec) / 1000L);
+}
+
+/* ---------- Tabela ---------- */
+
+static const char * pcNomeEstado(eTaskState eEstado)
+{
+    switch (eEstado)
+    {
+        case eRunning:   return "Rodando";
+        case eReady:     return "Pronta";
+        case eBlocked:   return "Bloqueada";
+        case eSuspended: return "Suspensa";
+        case eDeleted:   return "Removida";
+        default:         return "?";
+    }
+}
+
+/* Leitura anterior de cada task (pelo xTaskNumber), para o CPU% do intervalo. */
+static UBaseType_t uxNumeroAnterior[MAX_TASKS_MONITOR];
+static configRUN_TIME_COUNTER_TYPE ulContadorAnterior[MAX_TASKS_MONITOR];
+static UBaseType_t uxAnteriores = 0;
+static configRUN_TIME_COUNTER_TYPE ulTotalAnterior = 0;
+
+static configRUN_TIME_COUNTER_TYPE ulAnteriorDe(UBaseType_t uxNumero)
+{
+    for (UBaseType_t i = 0; i < uxAnteriores; i++)
+    {
+        if (uxNumeroAnterior[i] == uxNumero)
+        {
+            return ulContadorAnterior[i];
+        }
+    }
+    return 0;   /* task nova: conta desde que nasceu */
+}
+
+void vEstatImprimir(void)
+{
+    /* static: o vetor não vai para a pilha da task que chamou. */
+    static TaskStatus_t xStatus[MAX_TASKS_MONITOR];
+    configRUN_TIME_COUNTER_TYPE ulTotal;
+
+    UBaseType_t uxN = uxTaskGetSystemState(xStatus, MAX_TASKS_MONITOR, &ulTotal);
+    if (uxN == 0)
+    {
+        printf("[monitor] mais de %d tasks: aumente MAX_TASKS_MONITOR\n", MAX_TASKS_MONITOR);
+        return;
+    }
+
+    configRUN_TIME_COUNTER_TYPE ulIntervalo = ulTotal - ulTotalAnterior;
+
+    printf("\n--- CPU por task (t = %.1f s, intervalo %.1f s) ---\n",
+           ulTotal / 1e6, ulIntervalo / 1e6);
+    printf("%-12s %-10s %4s %9s %9s %12s\n",
+           "Task", "Estado", "Prio", "CPU% int", "CPU% tot", "Pilha livre");
+
+    for (UBaseType_t i = 0; i < uxN; i++)
+    {
+        TaskStatus_t *x = &xStatus[i];
+        configRUN_TIME_COUNTER_TYPE ulDelta = x->ulRunTimeCounter - ulAnteriorDe(x->xTaskNumber);
+
+        printf("%-12s %-10s %4u %8.1f%% %8.1f%% %10lu B\n",
+               x->pcTaskName, pcNomeEstado(x->eCurrentState),
+               (unsigned) x->uxCurrentPriority,
+               ulIntervalo ? 100.0 * ulDelta / ulIntervalo : 0.0,
+               ulTotal ? 100.0 * x->ulRunTimeCounter / ulTotal : 0.0,
+               (unsigned long) x->usStackHighWaterMark * sizeof(StackType_t));
+    }
+    vHeapImprimir();
+    fflush(stdout);
+
+    /* Guarda esta leitura como base do próximo intervalo. */
+    for (UBaseType_t i = 0; i < uxN; i++)
+    {
+        uxNumeroAnterior[i] = xStatus[i].xTaskNumber;
+        ulContadorAnterior[i] = xStatus[i].ulRunTimeCounter;
+    }
+    uxAnteriores = uxN;
+    ulTotalAnterior = ulTotal;
+}
+
+/* ---------- Task Monitor ---------- */
+
+#if ( projSTATIC_ALLOC == 1 )
+static StaticTask_t xTcbMonitor;
+static StackType_t uxPilhaMonitor[configMINIMAL_STACK_SIZE * 2];
+#endif
+
+static void vTaskMonitor(void *pvParameters)
+{
+    const TickType_t xPeriodo = pdMS_TO_TICKS((uint32_t) (uintptr_t) pvParameters);
+    TickType_t xUltimo = xTaskGetTickCount();
+
+    for (;;)
+    {
+        vTaskDelayUntil(&xUltimo, xPeriodo);
+        vEstatImprimir();
+    }
+}
+
+void vEstatIniciarMonitor(uint32_t ulPeriodoMs)
+{
+    if (ulPeriodoMs == 0)
+    {
+        return;
+    }
+
+    /* Prioridade alta (abaixo só do daemon de timers): mesmo com uma task
+     * monopolizando a CPU o monitor consegue imprimir. */
+    xBootTask(vTaskMonitor, "Monitor", configMINIMAL_STACK_SIZE * 2,
+              (void *) (uintptr_t) ulPeriodoMs, configMAX_PRIORITIES - 2,
+              BOOT_ESTATICO(uxPilhaMonitor), BOOT_ESTATICO(&xTcbMonitor));
+}
@@ -0,0 +1,43 @@
+/*
+ * runtime_stats.h — uso de CPU por task (run-time stats) no port POSIX
+ *
+ * O FreeRTOS soma, a cada troca de contexto, quanto tempo a task que sai
+ * ficou rodando. Para isso ele precisa de um contador de alta resolução:
+ *   - aqui o contador é CLOCK_MONOTONIC em microssegundos (64 bits no Linux,
+ *     não dá a volta), ligado pelo FreeRTOSConfig.h com
+ *       configRUN_TIME_COUNTER_TYPE          unsigned long
+ *       portALT_GET_RUN_TIME_COUNTER_VALUE   ulGetRunTimeCounterValue()
+ *     (o ALT tem precedência sobre o contador padrão do port, baseado em
+ *     times(), que só avança de 10 em 10 ms).
+ *   - a task "Monitor" chama uxTaskGetSystemState() periodicamente e imprime
+ *     uma tabela: CPU% no intervalo e desde o início, estado, prioridade e a
+ *     marca d'água da pilha (quanto da pilha NUNCA foi usado).
+ *     No fim da tabela sai uma linha do heap (heap_stats.h).
+ *
+ * Uso:
+ *   #include "runtime_stats.h"
+ *   vEstatIniciarMonitor(projRUNTIME_MONITOR_MS);   // antes do vTaskStartScheduler
+ *
+ * projRUNTIME_MONITOR_MS vem do Makefile (0 = sem monitor).
+ */
+
+#ifndef RUNTIME_STATS_H
+#define RUNTIME_STATS_H
+
+#include <stdint.h>
+
+#ifndef projRUNTIME_MONITOR_MS
+    #define projRUNTIME_MONITOR_MS    5000
+#endif
+
+/* Contador usado pelo kernel (µs desde a primeira chamada). */
+unsigned long ulGetRunTimeCounterValue(void);
+void vConfigureTimerForRunTimeStats(void);
+
+/* Cria a task de monitoramento (não faz nada se ulPeriodoMs == 0). */
+void vEstatIniciarMonitor(uint32_t ulPeriodoMs);
+
+/* Imprime a tabela uma vez (pode ser chamada de qualquer task). */
+void vEstatImprimir(void);
+
+#endif /* RUNTIME_STATS_H */
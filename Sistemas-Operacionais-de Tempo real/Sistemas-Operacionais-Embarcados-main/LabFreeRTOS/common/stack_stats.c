@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <string.h>   // memset (teste de estouro)
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "boot_stats.h"
+#include "stack_stats.h"
+
+#define MAX_TASKS_PILHA    32
+#define ARREDONDAMENTO     64      /* palavras */
+
+/* Teste de estouro: pilha acima do piso (senão a task roda na pilha da libc
+ * e não há o que estourar) e uma zona de sacrifício logo abaixo dela. */
+#define ESTOURO_PILHA      BOOT_PILHA_MIN
+#define ESTOURO_ZONA       512     /* palavras (4 KB) */
+#define ESTOURO_QUADRO     256     /* bytes por nível da recursão */
+
+#if ( projPILHA_TESTE_ESTOURO == 1 ) && ( configCHECK_FOR_STACK_OVERFLOW != 2 )
+    #error "projPILHA_TESTE_ESTOURO precisa de -DprojCHECK_STACK_OVERFLOW=2 (o método 1 não detecta nada no port POSIX)"
+#endif
+
+/* Instrumentos: fora da sugestão para as tasks da demo. */
+static TaskHandle_t xPilhas, xEstouro;
+
+/* ---------- Tamanho reservado de cada task ---------- */
+
+static uint32_t ulPilhaDe(TaskHandle_t xTask)
+{
+    uint32_t ulPilha = ulBootPilhaDe(xTask);
+
+    if (ulPilha != 0)
+    {
+        return ulPilha;
+    }
+    if (xTask == xTaskGetIdleTaskHandle())
+    {
+        return configMINIMAL_STACK_SIZE;
+    }
+    if (xTask == xTimerGetTimerDaemonTaskHandle())
+    {
+        return configTIMER_TASK_STACK_DEPTH;
+    }
+    if (xTask != NULL && xTask == xEstouro)
+    {
+        return ESTOURO_PILHA;   /* criada direto com xTaskCreateStatic */
+    }
+    return 0;   /* criada fora do xBootTask (ex.: TraceDump) */
+}
+
+/* ---------- Tabela ---------- */
+
+void vPilhaImprimir(void)
+{
+    /* static: o vetor não vai para a pilha que está sendo medida. */
+    static TaskStatus_t xStatus[MAX_TASKS_PILHA];
+    uint32_t ulMaiorDemo = 0;
+    int iAbaixoPiso = 0, iLibc = 0;
+
+    UBaseType_t uxN = uxTaskGetSystemState(xStatus, MAX_TASKS_PILHA, NULL);
+    if (uxN == 0)
+    {
+        printf("[pilhas] mais de %d tasks: aumente MAX_TASKS_PILHA\n", MAX_TASKS_PILHA);
+        return;
+    }
+
+    printf("\n--- Pilha por task (palavras de %u B, margem %d%%) ---\n",
+           (unsigned) sizeof(StackType_t), projPILHA_MARGEM_PCT);
+    printf("%-12s %8s %8s %8s %7s %9s\n", "Task", "pilha", "pico", "livre", "uso", "sugerida");
+
+    for (UBaseType_t i = 0; i < uxN; i++)
+    {
+        const TaskStatus_t *x = &xStatus[i];
+        const uint32_t ulLivre = (uint32_t) uxTaskGetStackHighWaterMark2(x->xHandle);
+        const uint32_t ulPilha = ulPilhaDe(x->xHandle);
+
+        if (ulPilha == 0)
+        {
+            printf("%-12s %8s %8s %8lu\n", x->pcTaskName, "?", "?", (unsigned long) ulLivre);
+            continue;
+        }
+        if (ulPilha < BOOT_PILHA_MIN)
+        {
+            /* Descontado o Thread_t que o port guarda no topo, sobra menos que
+             * PTHREAD_STACK_MIN: o pthread_attr_setstack recusa o vetor e a
+             * task roda na pilha da libc. */
+            printf("%-12s %8lu %8s %8lu %7s %9s !\n", x->pcTaskName, (unsigned long) ulPilha,
+                   "-", (unsigned long) ulLivre, "-", "-");
+            iLibc = 1;
+            continue;
+        }
+
+        const uint32_t ulPico = ulPilha - ulLivre;
+        const uint32_t ulSugerida = (ulPico * (100 + projPILHA_MARGEM_PCT) / 100 +
+                                     ARREDONDAMENTO - 1) / ARREDONDAMENTO * ARREDONDAMENTO;
+        const int iPiso = ulSugerida < BOOT_PILHA_MIN;
+
+        printf("%-12s %8lu %8lu %8lu %6.1f%% %9lu%s\n", x->pcTaskName,
+               (unsigned long) ulPilha, (unsigned long) ulPico, (unsigned long) ulLivre,
+               100.0 * ulPico / ulPilha, (unsigned long) ulSugerida, iPiso ? " *" : "");
+        iAbaixoPiso |= iPiso;
+
+        if (ulPilha == projPILHA_TASK && x->xHandle != xPilhas && x->xHandle != xEstouro &&
+            ulSugerida > ulMaiorDemo)
+        {
+            ulMaiorDemo = ulSugerida;
+        }
+    }
+
+    if (iAbaixoPiso)
+    {
+        printf("* abaixo do piso do port POSIX (%lu palavras): vale para uma MCU, aqui use o piso\n",
+               (unsigned long) BOOT_PILHA_MIN);
+    }
+    if (iLibc)
+    {
+        printf("! abaixo do piso (%lu palavras): o port roda a task na pilha da libc e não há o que medir\n",
+               (unsigned long) BOOT_PILHA_MIN);
+    }
+    if (ulMaiorDemo > 0)
+    {
+        printf("Tasks da demo: -DprojPILHA_TASK=%lu cobre todas (hoje %lu)\n",
+               (unsigned long) (ulMaiorDemo < BOOT_PILHA_MIN ? BOOT_PILHA_MIN : ulMaiorDemo),
+               (unsigned long) projPILHA_TASK);
+    }
+    fflush(stdout);
+}
+
+/* ---------- Teste de estouro ---------- */
+
+#if ( projPILHA_TESTE_ESTOURO == 1 )
+
+/* Sempre estático, mesmo com projSTATIC_ALLOC=0: o método 2 só percebe o
+ * estouro na troca de contexto seguinte e o hook ainda roda na pilha
+ * estourada (o printf dele desce uns 2 KB), então a escrita passa do fim
+ * da pilha — aqui ela cai na zona, e não no bloco vizinho do heap. */
+static StaticTask_t xTcbEstouro;
+static StackType_t uxZonaEPilhaEstouro[ESTOURO_ZONA + ESTOURO_PILHA];
+static volatile uint32_t ulNivelEstouro;
+
+/* Cada nível ocupa ~ESTOURO_QUADRO bytes de pilha, todos escritos (o memset
+ * passa por cima dos 16 bytes de 0xa5 no fim da pilha que o método 2
+ * confere). Sem printf aqui: ele desce bem abaixo do quadro e passaria do
+ * fim da pilha antes da conferência. noinline e as barreiras mantêm um
+ * quadro por nível, vivo durante a chamada — sem eles o -O2 junta vários
+ * níveis num quadro só ou transforma a recursão num laço. */
+static __attribute__((noinline)) void vDescer(uint32_t ulNivel)
+{
+    uint8_t ucQuadro[ESTOURO_QUADRO];
+
+    memset(ucQuadro, (int) ulNivel, sizeof(ucQuadro));
+    __asm__ volatile("" : : "r"(ucQuadro) : "memory");
+    ulNivelEstouro = ulNivel;
+
+    vTaskDelay(pdMS_TO_TICKS(100));   // troca de contexto: é aqui que o kernel confere
+
+    /* Pilha e zona inteiras já passaram: o hook devia ter disparado. */
+    if (ulNivel * ESTOURO_QUADRO >= (ESTOURO_PILHA + ESTOURO_ZONA) * sizeof(StackType_t))
+    {
+        printf("[Estouro] passou da zona no nível %lu sem o hook disparar\n",
+               (unsigned long) ulNivel);
+        fflush(stdout);
+        vTaskSuspend(NULL);
+        return;
+    }
+    vDescer(ulNivel + 1);
+
+    __asm__ volatile("" : : "r"(ucQuadro) : "memory");
+}
+
+static void vTaskEstouro(void *pvParameters)
+{
+    (void) pvParameters;
+
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    printf("[Estouro] descendo ~%d B a cada 100 ms numa pilha de %lu palavras\n",
+           ESTOURO_QUADRO, (unsigned long) ESTOURO_PILHA);
+    fflush(stdout);
+    vDescer(1);
+    for (;;);
+}
+
+#endif /* projPILHA_TESTE_ESTOURO */
+
+/* ---------- Hook de estouro ---------- */
+
+#if ( configCHECK_FOR_STACK_OVERFLOW > 0 )
+
+/* Chamado pelo kernel na troca de contexto quando a task que sai passou do
+ * limite. A pilha dela já está corrompida: só dá para avisar e parar. */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+    printf("ERRO: estouro de pilha na task %s!\n", pcTaskName);
+#if ( projPILHA_TESTE_ESTOURO == 1 )
+    if (xTask == xEstouro)
+    {
+        printf("(teste: nível %lu da recursão)\n", (unsigned long) ulNivelEstouro);
+    }
+#else
+    (void) xTask;
+#endif
+    fflush(stdout);
+    taskDISABLE_INTERRUPTS();
+    for(;;);
+}
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW */
+
+/* ---------- Task Pilhas ---------- */
+
+#if ( projSTATIC_ALLOC == 1 )
+static StaticTask_t xTcbPilhas;
+static StackType_t uxPilhaPilhas[BOOT_PILHA_MIN];
+#endif
+
+static void vTaskPilhas(void *pvParameters)
+{
+    const TickType_t xPeriodo = pdMS_TO_TICKS((uint32_t) (uintptr_t) pvParameters);
+    TickType_t xUltimo = xTaskGetTickCount();
+
+    for (;;)
+    {
+        vTaskDelayUntil(&xUltimo, xPeriodo);
+        vPilhaImprimir();
+    }
+}
+
+void vPilhaIniciar(uint32_t ulPeriodoMs)
+{
+#if ( projPILHA_TESTE_ESTOURO == 1 )
+    /* A pilha começa depois da zona: o que passar do fim cai nela. */
+    xEstouro = xTaskCreateStatic(vTaskEstouro, "Estouro", ESTOURO_PILHA, NULL, 1,
+                                 &uxZonaEPilhaEstouro[ESTOURO_ZONA], &xTcbEstouro);
+#endif
+
+    if (ulPeriodoMs == 0)
+    {
+        return;
+    }
+
+    /* Mesma prioridade do Monitor: mede mesmo com a CPU ocupada. */
+    xPilhas = xBootTask(vTaskPilhas, "Pilhas", BOOT_PILHA_MIN, (void *) (uintptr_t) ulPeriodoMs,
+                        configMAX_PRIORITIES - 2,
+                        BOOT_ESTATICO(uxPilhaPilhas), BOOT_ESTATICO(&xTcbPilhas));
+}
@@ -0,0 +1,46 @@
+/*
+ * stack_stats.h — pico de uso de pilha por task e tamanho sugerido
+ *
+ * A task "Pilhas" acorda a cada projPILHA_MONITOR_MS e, para cada task do
+ * sistema, lê uxTaskGetStackHighWaterMark2 (o mínimo de pilha livre desde
+ * que a task nasceu: o kernel enche a pilha com 0xa5 na criação e procura
+ * onde o padrão acaba). Com o tamanho reservado (registrado por xBootTask;
+ * Idle e daemon vêm do FreeRTOSConfig.h) a tabela mostra:
+ *   pilha, pico usado, uso% e a pilha sugerida = pico x (1 + margem),
+ *   arredondada para 64 palavras
+ * e uma linha com o -DprojPILHA_TASK que cobre todas as tasks da demo.
+ *
+ * Estouro: projCHECK_STACK_OVERFLOW (FreeRTOSConfig.h) vira
+ * configCHECK_FOR_STACK_OVERFLOW; vApplicationStackOverflowHook está no
+ * stack_stats.c. Com projPILHA_TESTE_ESTOURO=1 (exige
+ * projCHECK_STACK_OVERFLOW=2) uma task "Estouro" desce em recursão até o
+ * hook disparar.
+ *
+ * Uso:
+ *   vPilhaIniciar(projPILHA_MONITOR_MS);   // antes do vTaskStartScheduler
+ */
+
+#ifndef STACK_STATS_H
+#define STACK_STATS_H
+
+#include <stdint.h>
+
+#ifndef projPILHA_MONITOR_MS
+    #define projPILHA_MONITOR_MS       0       /* 0 = sem a task Pilhas */
+#endif
+
+#ifndef projPILHA_MARGEM_PCT
+    #define projPILHA_MARGEM_PCT       25      /* folga sobre o pico medido */
+#endif
+
+#ifndef projPILHA_TESTE_ESTOURO
+    #define projPILHA_TESTE_ESTOURO    0
+#endif
+
+/* Cria a task Pilhas (ulPeriodoMs > 0) e a de teste de estouro (se ligada). */
+void vPilhaIniciar(uint32_t ulPeriodoMs);
+
+/* Imprime a tabela uma vez (pode ser chamada de qualquer task). */
+void vPilhaImprimir(void);
+
+#endif /* STACK_STATS_H */
@@ -0,0 +1,335 @@
+/*
+ * trace2json.c — converte o arquivo do trace_ring (FreeRTOS) para o formato
+ * Chrome trace (JSON), aberto por https://ui.perfetto.dev ou chrome://tracing
+ *
+ * Roda no HOST (não usa o kernel):
+ *   gcc -O2 -Wall -o trace2json trace2json.c
+ *   ./trace2json trace.bin trace.json      # ou sem o 2º argumento: stdout
+ *
+ * O que aparece na linha do tempo:
+ *   - uma trilha por task (tid = nº da task): blocos B/E a cada fatia de CPU;
+ *   - eventos instantâneos na trilha da task que fez a operação: envio e
+ *     recebimento em fila, give/take de mutex e semáforo, bloqueio, timer;
+ *   - um contador (ph "C") com a ocupação de cada fila de dados.
+ * No stderr sai um resumo: CPU por task, trocas de contexto e operações por
+ * objeto, além do custo por evento medido no alvo.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace_ring.h"
+
+#define MAX_TASKS    256
+
+/* ucQueueType do FreeRTOS (queue.h) */
+#define FILA_DADOS       0
+#define FILA_MUTEX       1
+#define FILA_CONTADOR    2
+#define FILA_BINARIO     3
+#define FILA_RECURSIVO   4
+
+static TraceNome *xNomes;
+static uint32_t ulNomes;
+
+/* ---------- Nomes ---------- */
+
+static TraceNome *pxAchar(uint8_t ucTipo, uint32_t ulId)
+{
+    for (uint32_t i = 0; i < ulNomes; i++)
+    {
+        if (xNomes[i].ucTipo == ucTipo && xNomes[i].ulId == ulId)
+        {
+            return &xNomes[i];
+        }
+    }
+    return NULL;
+}
+
+static const char *pcCategoria(int iTipo)
+{
+    switch (iTipo)
+    {
+        case FILA_MUTEX:
+        case FILA_RECURSIVO: return "mutex";
+        case FILA_CONTADOR:
+        case FILA_BINARIO:   return "semaforo";
+        default:             return "fila";
+    }
+}
+
+static const char *pcNome(uint8_t ucTipo, uint32_t ulId)
+{
+    static char cBuf[4][32];
+    static int iProx = 0;
+    TraceNome *n = pxAchar(ucTipo, ulId);
+    char *p;
+
+    if (n != NULL && n->cNome[0] != '\0')
+    {
+        return n->cNome;
+    }
+    p = cBuf[iProx++ & 3];
+    snprintf(p, sizeof(cBuf[0]), "%s#%08x",
+             ucTipo == TR_OBJ_TASK ? "task" : ucTipo == TR_OBJ_TIMER ? "timer" :
+             n != NULL ? pcCategoria(n->ucSubtipo) : "obj",
+             (unsigned) ulId);
+    return p;
+}
+
+static int iSubtipo(uint32_t ulId)
+{
+    TraceNome *n = pxAchar(TR_OBJ_FILA, ulId);
+    return n != NULL ? n->ucSubtipo : FILA_DADOS;
+}
+
+static const char *pcOperacao(uint8_t ucEvento, int iTipo)
+{
+    int iSem = iTipo != FILA_DADOS;
+
+    switch (ucEvento)
+    {
+        case TR_FILA_ENVIA:       return iSem ? "give" : "envia";
+        case TR_FILA_RECEBE:      return iSem ? "take" : "recebe";
+        case TR_FILA_BLOQ_ENVIO:  return iSem ? "bloqueia no give" : "bloqueia (cheia)";
+        case TR_FILA_BLOQ_RECEBE: return iSem ? "bloqueia no take" : "bloqueia (vazia)";
+        default:                  return "?";
+    }
+}
+
+/* ---------- Resumo ---------- */
+
+typedef struct
+{
+    uint64_t ullCpuNs;
+    uint64_t ullEntrou;     /* início da fatia aberta (0 = fora da CPU) */
+    uint32_t ulFatias;
+} ResumoTask;
+
+typedef struct
+{
+    uint32_t ulId;
+    uint32_t ulEnvios, ulRecebimentos, ulBloqueios;
+} ResumoObjeto;
+
+static ResumoTask xTasks[MAX_TASKS];
+static ResumoObjeto xObjetos[TRACE_MAX_NOMES];
+static uint32_t ulObjetos = 0;
+
+static ResumoObjeto *pxObjeto(uint32_t ulId)
+{
+    for (uint32_t i = 0; i < ulObjetos; i++)
+    {
+        if (xObjetos[i].ulId == ulId)
+        {
+            return &xObjetos[i];
+        }
+    }
+    if (ulObjetos == TRACE_MAX_NOMES)
+    {
+        return NULL;
+    }
+    xObjetos[ulObjetos].ulId = ulId;
+    return &xObjetos[ulObjetos++];
+}
+
+/* ---------- Conversão ---------- */
+
+int main(int argc, char **argv)
+{
+    TraceCabecalho xCab;
+    TraceRegistro *pxReg;
+    FILE *in, *out = stdout;
+    uint64_t ullT0, ullFim;
+    int iPrimeiro = 1;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "uso: %s trace.bin [saida.json]\n", argv[0]);
+        return 1;
+    }
+
+    in = fopen(argv[1], "rb");
+    if (in == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    if (fread(&xCab, sizeof(xCab), 1, in) != 1 || xCab.ulMagico != TRACE_MAGICO ||
+        xCab.ulVersao != TRACE_VERSAO)
+    {
+        fprintf(stderr, "%s: não é um arquivo do trace_ring (versão %d)\n", argv[1], TRACE_VERSAO);
+        return 1;
+    }
+
+    ulNomes = xCab.ulNomes;
+    xNomes = calloc(ulNomes + 1, sizeof(TraceNome));
+    pxReg = calloc((size_t) xCab.ulRegistros + 1, sizeof(TraceRegistro));
+    if (xNomes == NULL || pxReg == NULL ||
+        fread(xNomes, sizeof(TraceNome), ulNomes, in) != ulNomes ||
+        fread(pxReg, sizeof(TraceRegistro), xCab.ulRegistros, in) != xCab.ulRegistros)
+    {
+        fprintf(stderr, "%s: arquivo truncado\n", argv[1]);
+        return 1;
+    }
+    fclose(in);
+
+    if (xCab.ulRegistros == 0)
+    {
+        fprintf(stderr, "%s: nenhum evento gravado\n", argv[1]);
+        return 1;
+    }
+
+    if (argc > 2)
+    {
+        out = fopen(argv[2], "w");
+        if (out == NULL)
+        {
+            perror(argv[2]);
+            return 1;
+        }
+    }
+
+    ullT0 = pxReg[0].ullTempoNs;
+    ullFim = pxReg[xCab.ulRegistros - 1].ullTempoNs;
+
+#define SEP()    (iPrimeiro ? (iPrimeiro = 0, "") : ",\n")
+#define TS( t )  (((t) - ullT0) / 1000.0)
+
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(out, "%s{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"FreeRTOS\"}}",
+            SEP());
+    for (uint32_t i = 0; i < ulNomes; i++)
+    {
+        if (xNomes[i].ucTipo == TR_OBJ_TASK)
+        {
+            fprintf(out, "%s{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\","
+                         "\"args\":{\"name\":\"%s\"}}",
+                    SEP(), (unsigned) xNomes[i].ulId, xNomes[i].cNome);
+        }
+    }
+
+    for (uint32_t i = 0; i < xCab.ulRegistros; i++)
+    {
+        TraceRegistro *r = &pxReg[i];
+        unsigned uTid = r->usTask;
+
+        switch (r->ucEvento)
+        {
+            case TR_TASK_ENTRA:
+            case TR_TASK_SAI:
+            {
+                ResumoTask *t = &xTasks[r->ulObjeto % MAX_TASKS];
+                if (r->ucEvento == TR_TASK_ENTRA)
+                {
+                    fprintf(out, "%s{\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":\"%s\","
+                                 "\"args\":{\"prio\":%u}}",
+                            SEP(), (unsigned) r->ulObjeto, TS(r->ullTempoNs),
+                            pcNome(TR_OBJ_TASK, r->ulObjeto), r->ucExtra);
+                    t->ullEntrou = r->ullTempoNs;
+                    t->ulFatias++;
+                }
+                else if (t->ullEntrou != 0)   /* SAI sem ENTRA: começo da janela */
+                {
+                    fprintf(out, "%s{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                            SEP(), (unsigned) r->ulObjeto, TS(r->ullTempoNs));
+                    t->ullCpuNs += r->ullTempoNs - t->ullEntrou;
+                    t->ullEntrou = 0;
+                }
+                break;
+            }
+
+            case TR_FILA_ENVIA:
+            case TR_FILA_RECEBE:
+            case TR_FILA_BLOQ_ENVIO:
+            case TR_FILA_BLOQ_RECEBE:
+            {
+                int iTipo = iSubtipo(r->ulObjeto);
+                ResumoObjeto *o = pxObjeto(r->ulObjeto);
+                const char *pcObj = pcNome(TR_OBJ_FILA, r->ulObjeto);
+
+                fprintf(out, "%s{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+                             "\"cat\":\"%s\",\"name\":\"%s %s\",\"args\":{\"itens\":%u}}",
+                        SEP(), uTid, TS(r->ullTempoNs), pcCategoria(iTipo),
+                        pcOperacao(r->ucEvento, iTipo), pcObj, r->ucExtra);
+
+                /* Ocupação da fila logo depois da operação. */
+                if (iTipo == FILA_DADOS && (r->ucEvento == TR_FILA_ENVIA || r->ucEvento == TR_FILA_RECEBE))
+                {
+                    fprintf(out, "%s{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":\"itens %s\","
+                                 "\"args\":{\"itens\":%d}}",
+                            SEP(), TS(r->ullTempoNs), pcObj,
+                            r->ucExtra + (r->ucEvento == TR_FILA_ENVIA ? 1 : -1));
+                }
+
+                if (o != NULL)
+                {
+                    if (r->ucEvento == TR_FILA_ENVIA)       o->ulEnvios++;
+                    else if (r->ucEvento == TR_FILA_RECEBE) o->ulRecebimentos++;
+                    else                                    o->ulBloqueios++;
+                }
+                break;
+            }
+
+            case TR_TIMER_EXPIROU:
+                fprintf(out, "%s{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+                             "\"cat\":\"timer\",\"name\":\"timer %s\"}",
+                        SEP(), uTid, TS(r->ullTempoNs), pcNome(TR_OBJ_TIMER, r->ulObjeto));
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /* Fecha as fatias que ainda estavam abertas no fim da janela. */
+    for (unsigned i = 0; i < MAX_TASKS; i++)
+    {
+        if (xTasks[i].ullEntrou != 0)
+        {
+            fprintf(out, "%s{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", SEP(), i, TS(ullFim));
+            xTasks[i].ullCpuNs += ullFim - xTasks[i].ullEntrou;
+        }
+    }
+    fprintf(out, "\n]}\n");
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    /* ---------- Resumo no stderr ---------- */
+    fprintf(stderr, "Janela: %.3f ms, %lu eventos (%llu gerados, %llu perdidos pelo anel), "
+                    "custo no alvo %.1f ns/evento\n",
+            (ullFim - ullT0) / 1e6, (unsigned long) xCab.ulRegistros,
+            (unsigned long long) xCab.ullGerados,
+            (unsigned long long) (xCab.ullGerados - xCab.ulRegistros), xCab.ullCustoPs / 1000.0);
+
+    fprintf(stderr, "%-16s %10s %6s %8s\n", "Task", "CPU (ms)", "CPU%", "Fatias");
+    for (unsigned i = 0; i < MAX_TASKS; i++)
+    {
+        if (xTasks[i].ulFatias > 0)
+        {
+            fprintf(stderr, "%-16s %10.3f %5.1f%% %8lu\n", pcNome(TR_OBJ_TASK, i),
+                    xTasks[i].ullCpuNs / 1e6,
+                    ullFim > ullT0 ? 100.0 * xTasks[i].ullCpuNs / (ullFim - ullT0) : 0.0,
+                    (unsigned long) xTasks[i].ulFatias);
+        }
+    }
+
+    if (ulObjetos > 0)
+    {
+        fprintf(stderr, "%-16s %-9s %8s %8s %9s\n", "Objeto", "Tipo", "Envios", "Receb.", "Bloqueios");
+        for (uint32_t i = 0; i < ulObjetos; i++)
+        {
+            ResumoObjeto *o = &xObjetos[i];
+            fprintf(stderr, "%-16s %-9s %8lu %8lu %9lu\n", pcNome(TR_OBJ_FILA, o->ulId),
+                    pcCategoria(iSubtipo(o->ulId)), (unsigned long) o->ulEnvios,
+                    (unsigned long) o->ulRecebimentos, (unsigned long) o->ulBloqueios);
+        }
+    }
+
+    free(xNomes);
+    free(pxReg);
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>     // clock_gettime (port POSIX)
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_stats.h"   // projHEAP
+
+/* Sem projENABLE_RING_TRACE o arquivo não gera nada (nem o anel de 1 MB). O
+ * trace_ring.h já veio pelo FreeRTOSConfig.h: incluí-lo depois do FreeRTOS.h
+ * redefiniria as macros trace*() vazias. */
+#if ( projENABLE_RING_TRACE == 1 )
+
+#define TRACE_CALIBRACAO    100000   /* eventos para medir o custo de um registro */
+
+/* ---------- Estado ---------- */
+
+TraceRegistro xTraceAnel[projTRACE_RING_TAM];
+uint32_t ulTraceProximo = 0;
+uint16_t usTraceTaskAtual = 0;
+volatile int xTraceLigado = 0;
+
+static TraceNome xNomes[TRACE_MAX_NOMES];
+static uint32_t ulNomes = 0;
+static uint64_t ullCustoPs = 0;
+
+/* ---------- Tabela de nomes ---------- */
+
+/* Chamado pelo kernel na criação dos objetos (já em seção crítica). */
+void vTraceNomear(uint8_t ucTipo, uint32_t ulId, uint8_t ucSubtipo, const char *pcNome)
+{
+    TraceNome *n = NULL;
+
+    for (uint32_t i = 0; i < ulNomes; i++)
+    {
+        if (xNomes[i].ucTipo == ucTipo && xNomes[i].ulId == ulId)
+        {
+            n = &xNomes[i];
+            break;
+        }
+    }
+
+    if (n == NULL)
+    {
+        if (ulNomes == TRACE_MAX_NOMES)
+        {
+            return;   /* tabela cheia: o conversor mostra só o id */
+        }
+        n = &xNomes[ulNomes++];
+        memset(n, 0, sizeof(*n));
+        n->ucTipo = ucTipo;
+        n->ulId = ulId;
+    }
+
+    if (ucSubtipo != 0xFF)
+    {
+        n->ucSubtipo = ucSubtipo;
+    }
+    if (pcNome != NULL)
+    {
+        strncpy(n->cNome, pcNome, TRACE_TAM_NOME - 1);
+        n->cNome[TRACE_TAM_NOME - 1] = '\0';
+    }
+}
+
+/* ---------- Arquivo ---------- */
+
+int xTraceSalvar(const char *pcArquivo)
+{
+    uint32_t ulTotal = ulTraceProximo;
+    uint32_t ulN = ulTotal < projTRACE_RING_TAM ? ulTotal : projTRACE_RING_TAM;
+    uint32_t ulInicio = (ulTotal - ulN) & (projTRACE_RING_TAM - 1);
+    uint32_t ulAteFim = projTRACE_RING_TAM - ulInicio;
+    TraceCabecalho xCab;
+    FILE *f = fopen(pcArquivo, "wb");
+
+    if (f == NULL)
+    {
+        perror(pcArquivo);
+        return -1;
+    }
+
+    xCab.ulMagico = TRACE_MAGICO;
+    xCab.ulVersao = TRACE_VERSAO;
+    xCab.ulNomes = ulNomes;
+    xCab.ulRegistros = ulN;
+    xCab.ullGerados = ulTotal;
+    xCab.ullCustoPs = ullCustoPs;
+    fwrite(&xCab, sizeof(xCab), 1, f);
+    fwrite(xNomes, sizeof(TraceNome), ulNomes, f);
+
+    /* Do mais antigo ao mais novo: [ulInicio, fim) e depois [0, resto). */
+    if (ulN <= ulAteFim)
+    {
+        fwrite(&xTraceAnel[ulInicio], sizeof(TraceRegistro), ulN, f);
+    }
+    else
+    {
+        fwrite(&xTraceAnel[ulInicio], sizeof(TraceRegistro), ulAteFim, f);
+        fwrite(&xTraceAnel[0], sizeof(TraceRegistro), ulN - ulAteFim, f);
+    }
+
+    if (fclose(f) != 0)
+    {
+        perror(pcArquivo);
+        return -1;
+    }
+
+    printf("[trace] %lu eventos gravados em %s (%llu gerados, %.1f ns/evento)\n",
+           (unsigned long) ulN, pcArquivo, (unsigned long long) xCab.ullGerados,
+           ullCustoPs / 1000.0);
+    fflush(stdout);
+    return 0;
+}
+
+/* ---------- Calibração ---------- */
+
+/* Mede o custo do caminho rápido (com o anel quente) e zera o anel. */
+static void vCalibrar(void)
+{
+    struct timespec a, b;
+
+    xTraceLigado = 1;
+    clock_gettime(CLOCK_MONOTONIC, &a);
+    for (uint32_t i = 0; i < TRACE_CALIBRACAO; i++)
+    {
+        vTraceRegistrar(TR_FILA_ENVIA, i, 0);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &b);
+    xTraceLigado = 0;
+
+    ullCustoPs = (uint64_t) ((b.tv_sec - a.tv_sec) * 1000000000LL + (b.tv_nsec - a.tv_nsec)) *
+                 1000ULL / TRACE_CALIBRACAO;
+    ulTraceProximo = 0;
+}
+
+/* ---------- Task TraceDump ---------- */
+
+static uint32_t ulDumpMs;
+static const char *pcArquivoSaida;
+
+static void vTaskTraceDump(void *pvParameters)
+{
+    (void) pvParameters;
+
+    vTaskDelay(pdMS_TO_TICKS(ulDumpMs));
+
+    /* Congela o anel antes de gravar: a gravação também geraria eventos. */
+    xTraceLigado = 0;
+    xTraceSalvar(pcArquivoSaida);
+
+#if ( projHEAP == 1 )
+    vTaskSuspend(NULL);   /* heap_1 não libera: o vTaskDelete daria assert no vPortFree */
+#else
+    vTaskDelete(NULL);
+#endif
+}
+
+void vTraceIniciar(uint32_t ulDuracaoMs, const char *pcArquivo)
+{
+    vCalibrar();
+    printf("[trace] anel de %u eventos (%lu KB), custo medido %.1f ns/evento; "
+           "gravando %s em %lu ms\n",
+           (unsigned) projTRACE_RING_TAM,
+           (unsigned long) (sizeof(xTraceAnel) / 1024), ullCustoPs / 1000.0,
+           pcArquivo, (unsigned long) ulDuracaoMs);
+
+    ulDumpMs = ulDuracaoMs;
+    pcArquivoSaida = pcArquivo;
+
+    /* Prioridade máxima: acorda pontualmente mesmo com tasks ocupadas. */
+    xTaskCreate(vTaskTraceDump, "TraceDump", configMINIMAL_STACK_SIZE * 4,
+                NULL, configMAX_PRIORITIES - 1, NULL);
+
+    xTraceLigado = 1;
+}
+
+#endif /* projENABLE_RING_TRACE == 1 */
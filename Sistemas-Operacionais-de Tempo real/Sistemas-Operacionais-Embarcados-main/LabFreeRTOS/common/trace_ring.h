@@ -0,0 +1,189 @@
+/*
+ * trace_ring.h — rastreamento binário de eventos do kernel (anel na RAM)
+ *
+ * Ideia:
+ *  - As macros trace*() do FreeRTOS são chamadas por dentro do kernel (tasks.c,
+ *    queue.c, timers.c) nos pontos interessantes. Aqui cada uma grava um
+ *    registro de TAMANHO FIXO (16 bytes) num vetor estático em potência de 2:
+ *    sem malloc, sem printf, sem lock — só clock_gettime (vDSO) e 4 stores.
+ *    O custo fica na casa das dezenas de ns por evento.
+ *  - O anel sobrescreve os mais antigos: fica sempre a janela mais recente.
+ *  - Os nomes (tasks, filas, timers) não vão em cada registro: são guardados
+ *    uma vez, na criação do objeto (traceTASK_CREATE, traceQUEUE_CREATE,
+ *    traceQUEUE_REGISTRY_ADD, traceTIMER_CREATE), numa tabela à parte.
+ *  - vTraceIniciar(ms, arquivo) cria a task "TraceDump": depois de 'ms' ela
+ *    desliga o rastreamento e grava o anel (em ordem cronológica) + a tabela
+ *    de nomes num arquivo binário. No host:
+ *        gcc -O2 -o trace2json ../common/trace2json.c
+ *        ./trace2json trace.bin trace.json
+ *    e abra o trace.json em https://ui.perfetto.dev ou chrome://tracing.
+ *
+ * Eventos gravados:
+ *   traceTASK_SWITCHED_IN / OUT       → fatia de CPU de cada task
+ *   traceQUEUE_SEND / RECEIVE         → filas, semáforos e mutexes (no FreeRTOS
+ *                                       xSemaphoreTake/Give de mutex passam por
+ *                                       aqui; o tipo vem da tabela de nomes)
+ *   traceBLOCKING_ON_QUEUE_SEND/RECEIVE → a task vai bloquear no objeto
+ *   traceTAKE_MUTEX_RECURSIVE         → xSemaphoreTakeRecursive
+ *   traceTIMER_EXPIRED                → callback de software timer
+ *
+ * Ligado por projENABLE_RING_TRACE=1 no Makefile (o FreeRTOSConfig.h inclui
+ * este arquivo). Tamanho do anel: projTRACE_RING_TAM registros.
+ */
+
+#ifndef TRACE_RING_H
+#define TRACE_RING_H
+
+#include <stdint.h>
+#include <time.h>     // clock_gettime (port POSIX)
+
+#ifndef projTRACE_RING_TAM
+    #define projTRACE_RING_TAM    65536     /* registros (potência de 2): 1 MB */
+#endif
+
+#ifndef projTRACE_DUMP_MS
+    #define projTRACE_DUMP_MS     3000      /* janela gravada pela task TraceDump */
+#endif
+
+#if ( projTRACE_RING_TAM & ( projTRACE_RING_TAM - 1 ) ) != 0
+    #error projTRACE_RING_TAM precisa ser potência de 2
+#endif
+
+#define TRACE_MAGICO          0x52545246UL  /* "FRTR" */
+#define TRACE_VERSAO          1
+#define TRACE_MAX_NOMES       64
+#define TRACE_TAM_NOME        16
+
+/* Tipos de evento (ucEvento) */
+enum
+{
+    TR_TASK_ENTRA = 1,
+    TR_TASK_SAI,
+    TR_FILA_ENVIA,
+    TR_FILA_RECEBE,
+    TR_FILA_BLOQ_ENVIO,
+    TR_FILA_BLOQ_RECEBE,
+    TR_TIMER_EXPIROU
+};
+
+/* Tipos de objeto na tabela de nomes */
+enum
+{
+    TR_OBJ_TASK = 1,
+    TR_OBJ_FILA,
+    TR_OBJ_TIMER
+};
+
+/* Registro gravado no anel: 16 bytes, sem ponteiros. */
+typedef struct
+{
+    uint64_t ullTempoNs;    /* CLOCK_MONOTONIC */
+    uint32_t ulObjeto;      /* nº da task (uxTCBNumber) ou id da fila/timer */
+    uint16_t usTask;        /* task que estava rodando */
+    uint8_t  ucEvento;      /* TR_* */
+    uint8_t  ucExtra;       /* prioridade (task) ou itens na fila antes da operação */
+} TraceRegistro;
+
+/* Entrada da tabela de nomes (24 bytes). */
+typedef struct
+{
+    uint8_t  ucTipo;        /* TR_OBJ_* */
+    uint8_t  ucSubtipo;     /* filas: ucQueueType (0 fila, 1 mutex, 2 contador, 3 binário, 4 recursivo) */
+    uint16_t usReservado;
+    uint32_t ulId;
+    char     cNome[TRACE_TAM_NOME];
+} TraceNome;
+
+/* Cabeçalho do arquivo; depois vêm ulNomes TraceNome e ulRegistros TraceRegistro. */
+typedef struct
+{
+    uint32_t ulMagico;
+    uint32_t ulVersao;
+    uint32_t ulNomes;
+    uint32_t ulRegistros;
+    uint64_t ullGerados;    /* total de eventos (> ulRegistros: o anel deu a volta) */
+    uint64_t ullCustoPs;    /* custo medido de um evento, em ps */
+} TraceCabecalho;
+
+extern TraceRegistro xTraceAnel[projTRACE_RING_TAM];
+extern uint32_t ulTraceProximo;
+extern uint16_t usTraceTaskAtual;
+extern volatile int xTraceLigado;
+
+/* Caminho rápido: chamado de dentro do kernel (seção crítica ou escalonador). */
+static inline void vTraceRegistrar(uint8_t ucEvento, uint32_t ulObjeto, uint8_t ucExtra)
+{
+    struct timespec ts;
+    TraceRegistro *r;
+
+    if (!xTraceLigado)
+    {
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    r = &xTraceAnel[ulTraceProximo++ & (projTRACE_RING_TAM - 1)];
+    r->ullTempoNs = (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+    r->ulObjeto = ulObjeto;
+    r->usTask = usTraceTaskAtual;
+    r->ucEvento = ucEvento;
+    r->ucExtra = ucExtra;
+}
+
+/* Guarda o nome de um objeto (pcNome == NULL mantém o nome já registrado). */
+void vTraceNomear(uint8_t ucTipo, uint32_t ulId, uint8_t ucSubtipo, const char *pcNome);
+
+/* Liga o rastreamento e cria a task que grava o arquivo depois de ulDuracaoMs. */
+void vTraceIniciar(uint32_t ulDuracaoMs, const char *pcArquivo);
+
+/* Grava o anel agora (0 = ok). Desligue o rastreamento antes (xTraceLigado = 0). */
+int xTraceSalvar(const char *pcArquivo);
+
+/* ---------- Macros do kernel ---------- */
+
+#define TR_ID( p )    ( ( uint32_t ) ( uintptr_t ) ( p ) )
+
+/* tasks.c: o nº da task já foi atribuído quando traceTASK_CREATE é chamado. */
+#define traceTASK_CREATE( pxNewTCB ) \
+    vTraceNomear( TR_OBJ_TASK, ( uint32_t ) ( pxNewTCB )->uxTCBNumber, 0, ( pxNewTCB )->pcTaskName )
+
+#define traceTASK_SWITCHED_IN()                                                 \
+    do {                                                                        \
+        usTraceTaskAtual = ( uint16_t ) pxCurrentTCB->uxTCBNumber;              \
+        vTraceRegistrar( TR_TASK_ENTRA, ( uint32_t ) pxCurrentTCB->uxTCBNumber, \
+                         ( uint8_t ) pxCurrentTCB->uxPriority );                \
+    } while( 0 )
+
+#define traceTASK_SWITCHED_OUT() \
+    vTraceRegistrar( TR_TASK_SAI, ( uint32_t ) pxCurrentTCB->uxTCBNumber, ( uint8_t ) pxCurrentTCB->uxPriority )
+
+/* queue.c: ucQueueType existe com configUSE_TRACE_FACILITY == 1. */
+#define traceQUEUE_CREATE( pxNewQueue ) \
+    vTraceNomear( TR_OBJ_FILA, TR_ID( pxNewQueue ), ( pxNewQueue )->ucQueueType, NULL )
+
+#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName ) \
+    vTraceNomear( TR_OBJ_FILA, TR_ID( xQueue ), 0xFF, pcQueueName )
+
+#define traceQUEUE_SEND( pxQueue ) \
+    vTraceRegistrar( TR_FILA_ENVIA, TR_ID( pxQueue ), ( uint8_t ) ( pxQueue )->uxMessagesWaiting )
+
+#define traceQUEUE_RECEIVE( pxQueue ) \
+    vTraceRegistrar( TR_FILA_RECEBE, TR_ID( pxQueue ), ( uint8_t ) ( pxQueue )->uxMessagesWaiting )
+
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue ) \
+    vTraceRegistrar( TR_FILA_BLOQ_ENVIO, TR_ID( pxQueue ), ( uint8_t ) ( pxQueue )->uxMessagesWaiting )
+
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue ) \
+    vTraceRegistrar( TR_FILA_BLOQ_RECEBE, TR_ID( pxQueue ), ( uint8_t ) ( pxQueue )->uxMessagesWaiting )
+
+#define traceTAKE_MUTEX_RECURSIVE( pxMutex ) \
+    vTraceRegistrar( TR_FILA_RECEBE, TR_ID( pxMutex ), 0 )
+
+/* timers.c */
+#define traceTIMER_CREATE( pxNewTimer ) \
+    vTraceNomear( TR_OBJ_TIMER, TR_ID( pxNewTimer ), 0, ( pxNewTimer )->pcTimerName )
+
+#define traceTIMER_EXPIRED( pxTimer ) \
+    vTraceRegistrar( TR_TIMER_EXPIROU, TR_ID( pxTimer ), 0 )
+
+#endif /* TRACE_RING_H */
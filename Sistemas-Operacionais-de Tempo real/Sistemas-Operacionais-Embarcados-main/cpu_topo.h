@@ -0,0 +1,297 @@
+/*
+ * cpu_topo.h — topologia de CPUs e posicionamento (afinidade) de threads
+ *
+ * Ideia:
+ *  - Sem afinidade o kernel coloca cada thread onde achar melhor e ainda pode
+ *    migrá-la. Para medir (ou controlar) é melhor decidir ONDE cada thread roda,
+ *    e isso depende da topologia:
+ *      CPU lógica  → o que o kernel numera (cpu0, cpu1, ...)
+ *      irmãs SMT   → CPUs lógicas do MESMO core físico (Hyper-Threading):
+ *                    dividem unidades de execução e cache L1/L2
+ *      LLC         → grupo de cores que divide o último nível de cache (L3)
+ *      pacote      → soquete físico
+ *  - topo_ler() lê /sys/devices/system/cpu (topology/ e cache/index*), só para
+ *    as CPUs permitidas ao processo (sched_getaffinity: respeita taskset e
+ *    cgroups) e marca as CPUs isoladas (parâmetro isolcpus= do kernel).
+ *  - topo_cpu_para() escolhe a CPU da i-ésima thread segundo uma política:
+ *      livre      → sem afinidade (o kernel decide)
+ *      compactar  → enche um core (irmãs SMT) e um LLC antes de passar adiante:
+ *                   dados compartilhados ficam na mesma cache
+ *      espalhar   → uma thread por LLC/core antes de repetir; irmãs SMT por último:
+ *                   máximo de recursos por thread
+ *      sem_smt    → só a primeira CPU lógica de cada core (as irmãs ficam ociosas)
+ *      dedicado   → um core inteiro por thread, sem repetir; prefere CPUs
+ *                   isoladas e deixa o core 0 para a main e o sistema quando
+ *                   há cores de sobra. Falta core → -1 (quem chama decide).
+ *
+ * Uso típico:
+ *   Topologia topo;
+ *   topo_ler(&topo);
+ *   int cpu = topo_cpu_para(&topo, TOPO_ESPALHAR, i);
+ *   topo_fixar_attr(&attr, cpu);            // antes do pthread_create
+ *
+ * Observação:
+ *   - Em máquina virtual a topologia exposta pode não ser a real (vCPUs sem
+ *     irmãs SMT, um LLC só...): as políticas continuam válidas, mas várias
+ *     delas viram a mesma distribuição.
+ */
+
+#ifndef CPU_TOPO_H
+#define CPU_TOPO_H
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE           // cpu_set_t, pthread_attr_setaffinity_np
+#endif
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TOPO_MAX_CPUS 256
+
+typedef struct {
+    int cpu;          // número lógico
+    int core;         // índice do core físico (0..n_cores-1)
+    int smt;          // posição entre as irmãs SMT do core (0 = primeira)
+    int llc;          // índice do grupo que divide o último nível de cache
+    int pacote;       // physical_package_id
+    int isolada;      // está em /sys/devices/system/cpu/isolated
+} TopoCpu;
+
+typedef struct {
+    int n_cpus, n_cores, n_llc, n_isoladas;
+    TopoCpu cpus[TOPO_MAX_CPUS];      // em ordem crescente de número lógico
+} Topologia;
+
+typedef enum {
+    TOPO_LIVRE, TOPO_COMPACTAR, TOPO_ESPALHAR, TOPO_SEM_SMT, TOPO_DEDICADO
+} TopoPolitica;
+
+static const char *const TOPO_NOMES[] = {
+    [TOPO_LIVRE] = "livre", [TOPO_COMPACTAR] = "compactar", [TOPO_ESPALHAR] = "espalhar",
+    [TOPO_SEM_SMT] = "sem_smt", [TOPO_DEDICADO] = "dedicado",
+};
+
+// -1 se o nome não for de nenhuma política.
+static inline int topo_politica(const char *nome) {
+    for (int p = TOPO_LIVRE; p <= TOPO_DEDICADO; p++)
+        if (strcmp(nome, TOPO_NOMES[p]) == 0)
+            return p;
+    return -1;
+}
+
+// ----------------------------------------------------------------------------
+// Leitura de /sys
+// ----------------------------------------------------------------------------
+static inline int topo_ler_int(const char *caminho, int padrao) {
+    FILE *f = fopen(caminho, "r");
+    int v;
+    if (f == NULL)
+        return padrao;
+    if (fscanf(f, "%d", &v) != 1)
+        v = padrao;
+    fclose(f);
+    return v;
+}
+
+// Lista de CPUs no formato do kernel ("0-3,8,10-11"). Retorna quantas leu
+// (0 se o arquivo não existe ou está vazio).
+static inline int topo_ler_lista(const char *caminho, cpu_set_t *cpus) {
+    CPU_ZERO(cpus);
+    FILE *f = fopen(caminho, "r");
+    if (f == NULL)
+        return 0;
+    char buf[1024];
+    int n = 0;
+    if (fgets(buf, sizeof(buf), f)) {
+        for (char *p = buf; *p && *p != '\n';) {
+            char *fim;
+            long a = strtol(p, &fim, 10), b = a;
+            if (fim == p)
+                break;
+            if (*fim == '-')
+                b = strtol(fim + 1, &fim, 10);
+            for (long c = a; c <= b && c < CPU_SETSIZE; c++, n++)
+                CPU_SET(c, cpus);
+            p = *fim == ',' ? fim + 1 : fim;
+        }
+    }
+    fclose(f);
+    return n;
+}
+
+// Menor CPU de um conjunto (identifica o grupo: core, LLC...).
+static inline int topo_primeira(const cpu_set_t *cpus, int padrao) {
+    for (int c = 0; c < CPU_SETSIZE; c++)
+        if (CPU_ISSET(c, cpus))
+            return c;
+    return padrao;
+}
+
+// Converte uma "chave" de grupo (menor CPU do grupo) em índice 0..n-1.
+static inline int topo_indice(int *chaves, int *n, int chave) {
+    for (int i = 0; i < *n; i++)
+        if (chaves[i] == chave)
+            return i;
+    chaves[*n] = chave;
+    return (*n)++;
+}
+
+static inline int topo_ler(Topologia *t) {
+    memset(t, 0, sizeof(*t));
+    cpu_set_t permitidas, isoladas;
+    if (sched_getaffinity(0, sizeof(permitidas), &permitidas) != 0) {
+        perror("sched_getaffinity");
+        return -1;
+    }
+    topo_ler_lista("/sys/devices/system/cpu/isolated", &isoladas);
+
+    int chave_core[TOPO_MAX_CPUS], chave_llc[TOPO_MAX_CPUS];
+    char caminho[160];
+    for (int c = 0; c < CPU_SETSIZE && t->n_cpus < TOPO_MAX_CPUS; c++) {
+        if (!CPU_ISSET(c, &permitidas))
+            continue;
+        TopoCpu *k = &t->cpus[t->n_cpus++];
+        k->cpu = c;
+        k->isolada = CPU_ISSET(c, &isoladas) != 0;
+        t->n_isoladas += k->isolada;
+
+        snprintf(caminho, sizeof(caminho),
+                 "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", c);
+        k->pacote = topo_ler_int(caminho, 0);
+
+        // Irmãs SMT: o core é identificado pela menor irmã; a posição da CPU
+        // entre as irmãs permitidas dá o índice SMT.
+        cpu_set_t irmas;
+        snprintf(caminho, sizeof(caminho),
+                 "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", c);
+        if (topo_ler_lista(caminho, &irmas) == 0)
+            CPU_SET(c, &irmas);
+        k->core = topo_indice(chave_core, &t->n_cores, topo_primeira(&irmas, c));
+        for (int i = 0; i < c; i++)
+            k->smt += CPU_ISSET(i, &irmas) && CPU_ISSET(i, &permitidas);
+
+        // LLC: a cache de maior nível (index0..N); o grupo é shared_cpu_list.
+        int nivel_max = 0, chave = c;
+        for (int idx = 0; idx < 10; idx++) {
+            snprintf(caminho, sizeof(caminho),
+                     "/sys/devices/system/cpu/cpu%d/cache/index%d/level", c, idx);
+            int nivel = topo_ler_int(caminho, -1);
+            if (nivel < 0)
+                break;
+            if (nivel < nivel_max)
+                continue;
+            cpu_set_t grupo;
+            snprintf(caminho, sizeof(caminho),
+                     "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", c, idx);
+            if (topo_ler_lista(caminho, &grupo) > 0) {
+                nivel_max = nivel;
+                chave = topo_primeira(&grupo, c);
+            }
+        }
+        k->llc = topo_indice(chave_llc, &t->n_llc, chave);
+    }
+    return t->n_cpus > 0 ? 0 : -1;
+}
+
+static inline void topo_imprimir(const Topologia *t) {
+    printf("Topologia: %d CPUs permitidas | %d cores | %d grupos de LLC | %d isoladas\n",
+           t->n_cpus, t->n_cores, t->n_llc, t->n_isoladas);
+    printf("  %4s %5s %4s %4s %7s %8s\n", "cpu", "core", "smt", "llc", "pacote", "isolada");
+    for (int i = 0; i < t->n_cpus; i++) {
+        const TopoCpu *k = &t->cpus[i];
+        printf("  %4d %5d %4d %4d %7d %8s\n", k->cpu, k->core, k->smt, k->llc, k->pacote,
+               k->isolada ? "sim" : "-");
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Políticas
+// ----------------------------------------------------------------------------
+// Posição do core entre os cores do seu LLC (0, 1, 2...).
+static inline int topo_rank_no_llc(const Topologia *t, const TopoCpu *k) {
+    int rank = 0;
+    for (int i = 0; i < t->n_cpus; i++) {
+        const TopoCpu *o = &t->cpus[i];
+        rank += o->smt == 0 && o->llc == k->llc && o->core < k->core;   // um por core
+    }
+    return rank;
+}
+
+// Ordem de ocupação das CPUs para uma política. Retorna quantas CPUs entram.
+static inline int topo_ordem(const Topologia *t, TopoPolitica pol, int *ordem) {
+    long chave[TOPO_MAX_CPUS];
+    int n = 0;
+    int sobra_core = t->n_cores > 1;          // dedicado: poupa o core 0
+    for (int i = 0; i < t->n_cpus; i++) {
+        const TopoCpu *k = &t->cpus[i];
+        long c;
+        switch (pol) {
+        case TOPO_COMPACTAR:
+            c = ((long)k->llc * TOPO_MAX_CPUS + k->core) * TOPO_MAX_CPUS + k->smt;
+            break;
+        case TOPO_ESPALHAR:
+            c = ((long)k->smt * TOPO_MAX_CPUS + topo_rank_no_llc(t, k)) * TOPO_MAX_CPUS + k->llc;
+            break;
+        case TOPO_SEM_SMT:
+            if (k->smt != 0)
+                continue;
+            c = k->core;
+            break;
+        case TOPO_DEDICADO:
+            if (k->smt != 0 || (sobra_core && k->core == t->cpus[0].core))
+                continue;
+            c = (long)!k->isolada * TOPO_MAX_CPUS + k->core;    // isoladas primeiro
+            break;
+        default:
+            return 0;
+        }
+        // Inserção ordenada (poucas CPUs, sem qsort com contexto).
+        int j = n++;
+        while (j > 0 && chave[j - 1] > c) {
+            chave[j] = chave[j - 1];
+            ordem[j] = ordem[j - 1];
+            j--;
+        }
+        chave[j] = c;
+        ordem[j] = k->cpu;
+    }
+    return n;
+}
+
+// CPU da i-ésima thread (-1 = sem afinidade, ou sem core livre em "dedicado").
+static inline int topo_cpu_para(const Topologia *t, TopoPolitica pol, int i) {
+    int ordem[TOPO_MAX_CPUS];
+    int n = topo_ordem(t, pol, ordem);
+    if (n == 0)
+        return -1;
+    if (pol == TOPO_DEDICADO)
+        return i < n ? ordem[i] : -1;
+    return ordem[i % n];
+}
+
+static inline void topo_conjunto(int cpu, cpu_set_t *cpus) {
+    CPU_ZERO(cpus);
+    CPU_SET(cpu, cpus);
+}
+
+// Afinidade no atributo (a thread já nasce na CPU certa). cpu < 0: nada muda.
+static inline int topo_fixar_attr(pthread_attr_t *attr, int cpu) {
+    if (cpu < 0)
+        return 0;
+    cpu_set_t cpus;
+    topo_conjunto(cpu, &cpus);
+    return pthread_attr_setaffinity_np(attr, sizeof(cpus), &cpus);
+}
+
+// Afinidade de uma thread que já existe.
+static inline int topo_fixar(pthread_t th, int cpu) {
+    if (cpu < 0)
+        return 0;
+    cpu_set_t cpus;
+    topo_conjunto(cpu, &cpus);
+    return pthread_setaffinity_np(th, sizeof(cpus), &cpus);
+}
+
+#endif
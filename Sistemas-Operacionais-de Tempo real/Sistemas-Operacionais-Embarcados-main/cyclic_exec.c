@@ -0,0 +1,282 @@
+/*
+ * Executivo CÍCLICO com timerfd (quadros menores / quadro maior)
+ *
+ * Ideia:
+ *  - Em vez de tarefas "soltas" que dormem cada uma no seu ritmo (como no
+ *    Exemplo01_3Tasks do FreeRTOS), UMA única thread segue uma TABELA estática:
+ *      quadro maior  = ciclo completo da tabela (aqui 8 quadros menores);
+ *      quadro menor  = fatia fixa de tempo (padrão 10 ms) disparada por um timerfd.
+ *    Cada entrada da tabela lista os jobs que rodam naquele quadro menor.
+ *  - Um único timerfd periódico (CLOCK_MONOTONIC) marca o início de cada quadro.
+ *    O read() devolve quantas expirações ocorreram desde a última leitura:
+ *    se for > 1, perdemos quadros (o executivo pula para o quadro certo, para
+ *    a tabela continuar alinhada com o tempo).
+ *  - Estouro de quadro: os jobs do quadro terminaram depois do fim nominal.
+ *  - Por quadro da tabela: folga (tempo que sobrou até o próximo quadro) e
+ *    jitter de início (atraso entre o instante nominal e o começo real), com
+ *    histogramas.
+ *
+ * Tabela de exemplo (A a cada 20 ms, B a cada 40 ms, C a cada 80 ms):
+ *   quadro:  0     1     2     3     4     5     6     7
+ *   jobs:    A,B   C     A     -     A,B   -     A     -
+ *
+ * Como compilar:
+ *   gcc -O2 cyclic_exec.c -o cyclic_exec
+ *
+ * Como executar:
+ *   ./cyclic_exec                     (5 s, quadro menor de 10 ms)
+ *   sudo ./cyclic_exec -d 30 -f 5     (SCHED_FIFO, quadro de 5 ms)
+ *   ./cyclic_exec -x 10               (a cada 10 quadros maiores, C estoura)
+ *
+ * Opções:
+ *   -d S     duração em segundos (padrão 5)
+ *   -f MS    quadro menor em ms (padrão 10; os jobs escalam junto)
+ *   -x N     injeta um estouro no quadro 1 a cada N quadros maiores
+ *
+ * Observação:
+ *   - Com sudo a thread roda em SCHED_FIFO 80; sem permissão, avisa e segue em
+ *     SCHED_OTHER (o jitter fica bem maior).
+ */
+
+#define _GNU_SOURCE           // sched_setscheduler
+#include <stdio.h>           // printf, perror
+#include <stdlib.h>          // atoi, exit
+#include <stdint.h>          // uint64_t
+#include <string.h>          // strerror
+#include <errno.h>           // errno
+#include <unistd.h>          // read, getopt
+#include <sched.h>           // sched_setscheduler
+#include <sys/timerfd.h>     // timerfd_create, timerfd_settime
+#include <time.h>            // clock_gettime
+
+#define N_QUADROS      8      // quadros menores por quadro maior
+#define MAX_JOBS       4      // jobs por quadro
+#define N_BALDES       10     // histogramas: 10 baldes + estouro
+
+// ----------------------------------------------------------------------------
+// Jobs (carga sintética proporcional ao quadro menor)
+// ----------------------------------------------------------------------------
+static long quadro_us = 10000;         // quadro menor
+static int injetar_a_cada = 0;         // -x
+static long long quadro_maior_atual;   // para a injeção de estouro
+
+static long long agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static long long cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Gira até consumir 'permil' milésimos do quadro menor em CPU.
+static void girar(long permil) {
+    long long fim = cpu_ns() + quadro_us * 1000LL * permil / 1000;
+    while (cpu_ns() < fim)
+        ;
+}
+
+static void job_A(void) { girar(200); }    // 20% do quadro
+static void job_B(void) { girar(300); }    // 30%
+static void job_C(void) {
+    // Estouro injetado: 130% do quadro (passa do fim e "come" o próximo).
+    if (injetar_a_cada > 0 && quadro_maior_atual % injetar_a_cada == injetar_a_cada - 1)
+        girar(1300);
+    else
+        girar(500);                            // 50%
+}
+
+typedef struct {
+    const char *nome;
+    void (*fn)(void);
+} Job;
+
+static const Job A = { "A", job_A }, B = { "B", job_B }, C = { "C", job_C };
+
+// Tabela estática: quadro menor → lista de jobs (terminada em NULL).
+static const Job *const TABELA[N_QUADROS][MAX_JOBS + 1] = {
+    { &A, &B, NULL },
+    { &C, NULL },
+    { &A, NULL },
+    { NULL },
+    { &A, &B, NULL },
+    { NULL },
+    { &A, NULL },
+    { NULL },
+};
+
+// ----------------------------------------------------------------------------
+// Estatística por quadro da tabela
+// ----------------------------------------------------------------------------
+typedef struct {
+    long long execucoes, estouros;
+    long long folga_min, folga_max, folga_soma;      // ns (negativa = estouro)
+    long long jit_max, jit_soma;                     // ns
+    long long hist_folga[N_BALDES + 1];              // % do quadro; [N_BALDES] = estouro
+    long long hist_jit[N_BALDES + 1];                // baldes de 5% do quadro; último = acima
+} EstatQuadro;
+
+static EstatQuadro est[N_QUADROS];
+
+static void registrar(int q, long long jitter, long long folga) {
+    EstatQuadro *e = &est[q];
+    if (e->execucoes == 0 || folga < e->folga_min) e->folga_min = folga;
+    if (e->execucoes == 0 || folga > e->folga_max) e->folga_max = folga;
+    if (jitter > e->jit_max) e->jit_max = jitter;
+    e->folga_soma += folga;
+    e->jit_soma += jitter;
+    e->execucoes++;
+
+    const long long quadro_ns = quadro_us * 1000LL;
+    if (folga < 0) {
+        e->estouros++;
+        e->hist_folga[N_BALDES]++;
+    } else {
+        int b = (int)(folga * N_BALDES / quadro_ns);
+        e->hist_folga[b < N_BALDES ? b : N_BALDES - 1]++;
+    }
+    int bj = (int)(jitter * 20 / quadro_ns);         // 5% do quadro por balde
+    e->hist_jit[bj < N_BALDES ? bj : N_BALDES]++;
+}
+
+static void imprimir_hist(const char *titulo, const char *rotulos_ultimo, long long h[][N_BALDES + 1],
+                          int passo_pct) {
+    printf("\n%s\n%-9s", titulo, "faixa");
+    for (int q = 0; q < N_QUADROS; q++)
+        printf(" %7s%d", "q", q);
+    printf("\n");
+    for (int b = 0; b <= N_BALDES; b++) {
+        int vazio = 1;
+        for (int q = 0; q < N_QUADROS; q++)
+            if (h[q][b]) vazio = 0;
+        if (vazio)
+            continue;
+        if (b < N_BALDES)
+            printf("%3d-%3d%% ", b * passo_pct, (b + 1) * passo_pct);
+        else
+            printf("%-9s", rotulos_ultimo);
+        for (int q = 0; q < N_QUADROS; q++)
+            printf(" %8lld", h[q][b]);
+        printf("\n");
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Programa principal
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    int duracao_s = 5, op;
+    while ((op = getopt(argc, argv, "d:f:x:")) != -1) {
+        switch (op) {
+        case 'd': duracao_s = atoi(optarg); break;
+        case 'f': quadro_us = (long)(atof(optarg) * 1000); break;
+        case 'x': injetar_a_cada = atoi(optarg); break;
+        default:
+            fprintf(stderr, "uso: %s [-d segundos] [-f quadro_ms] [-x N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (duracao_s < 1 || quadro_us < 100) {
+        fprintf(stderr, "duração >= 1 s e quadro >= 0,1 ms\n");
+        return 1;
+    }
+
+    struct sched_param sp = { .sched_priority = 80 };
+    int rt = sched_setscheduler(0, SCHED_FIFO, &sp) == 0;
+    if (!rt)
+        fprintf(stderr, "⚠️  SCHED_FIFO negado (%s): rodando em SCHED_OTHER.\n", strerror(errno));
+
+    // Um único timer periódico: primeiro disparo em t0, depois a cada quadro.
+    int tfd = timerfd_create(CLOCK_MONOTONIC, 0);
+    if (tfd < 0) {
+        perror("timerfd_create");
+        return 1;
+    }
+    long long t0 = agora_ns() + 10000000LL;         // começa daqui a 10 ms
+    struct itimerspec its = {
+        .it_value    = { .tv_sec = t0 / 1000000000LL, .tv_nsec = t0 % 1000000000LL },
+        .it_interval = { .tv_sec = quadro_us / 1000000, .tv_nsec = (quadro_us % 1000000) * 1000 },
+    };
+    if (timerfd_settime(tfd, TFD_TIMER_ABSTIME, &its, NULL) != 0) {
+        perror("timerfd_settime");
+        return 1;
+    }
+
+    printf("=== Executivo cíclico: quadro menor %.2f ms x %d = quadro maior %.2f ms | %s ===\n",
+           quadro_us / 1e3, N_QUADROS, quadro_us * N_QUADROS / 1e3,
+           rt ? "SCHED_FIFO 80" : "SCHED_OTHER");
+
+    const long long quadro_ns = quadro_us * 1000LL;
+    const long long total = (long long)duracao_s * 1000000000LL / quadro_ns;
+    long long k = 0;                  // índice absoluto do quadro menor atual
+    long long perdidos = 0, leituras = 0;
+
+    while (k < total) {
+        uint64_t expiracoes;
+        ssize_t r = read(tfd, &expiracoes, sizeof(expiracoes));   // bloqueia até o tick
+        if (r != sizeof(expiracoes)) {
+            if (r < 0 && errno == EINTR)
+                continue;
+            perror("read(timerfd)");
+            return 1;
+        }
+        long long inicio = agora_ns();
+        leituras++;
+
+        // Mais de uma expiração = quadros inteiros que passaram sem rodar
+        // (o quadro anterior estourou ou a thread não foi escalonada a tempo).
+        // Pulamos para o quadro correspondente ao tempo atual.
+        if (expiracoes > 1) {
+            perdidos += (long long)expiracoes - 1;
+            k += (long long)expiracoes - 1;
+            if (k >= total)
+                break;
+        }
+        int q = (int)(k % N_QUADROS);
+        quadro_maior_atual = k / N_QUADROS;
+        long long nominal = t0 + k * quadro_ns;
+
+        for (const Job *const *j = TABELA[q]; *j != NULL; j++)
+            (*j)->fn();
+
+        long long fim = agora_ns();
+        registrar(q, inicio - nominal, nominal + quadro_ns - fim);
+        k++;
+    }
+    close(tfd);
+
+    // ------------------------------- Relatório -------------------------------
+    printf("\nQuadros executados: %lld | expirações perdidas (contador do timerfd): %lld\n\n",
+           leituras, perdidos);
+    printf("%-7s %-8s %6s %8s %10s %10s %10s %10s %10s\n", "quadro", "jobs", "execs", "estouros",
+           "folga mín", "folga méd", "folga máx", "jit méd", "jit máx");
+    for (int q = 0; q < N_QUADROS; q++) {
+        char jobs[16] = "";
+        for (const Job *const *j = TABELA[q]; *j != NULL; j++)
+            snprintf(jobs + strlen(jobs), sizeof(jobs) - strlen(jobs), "%s%s",
+                     jobs[0] ? "," : "", (*j)->nome);
+        EstatQuadro *e = &est[q];
+        if (e->execucoes == 0) {
+            printf("%-7d %-8s %6d\n", q, jobs[0] ? jobs : "-", 0);
+            continue;
+        }
+        printf("%-7d %-8s %6lld %8lld %10.3f %10.3f %10.3f %10.3f %10.3f\n", q,
+               jobs[0] ? jobs : "-", e->execucoes, e->estouros,
+               e->folga_min / 1e6, e->folga_soma / 1e6 / e->execucoes, e->folga_max / 1e6,
+               e->jit_soma / 1e6 / e->execucoes, e->jit_max / 1e6);
+    }
+    printf("(tempos em ms; folga negativa = estouro do quadro)\n");
+
+    long long hf[N_QUADROS][N_BALDES + 1], hj[N_QUADROS][N_BALDES + 1];
+    for (int q = 0; q < N_QUADROS; q++)
+        for (int b = 0; b <= N_BALDES; b++) {
+            hf[q][b] = est[q].hist_folga[b];
+            hj[q][b] = est[q].hist_jit[b];
+        }
+    imprimir_hist("Histograma de folga (% do quadro menor)", "estouro", hf, 100 / N_BALDES);
+    imprimir_hist("Histograma de jitter de início (% do quadro menor)", ">= 50%", hj, 5);
+    return 0;
+}
@@ -0,0 +1,219 @@
+// ============================================================================
+//  futex_sem.h
+// ============================================================================
+// Semáforo contador leve, implementado em espaço de usuário sobre futex(2).
+//
+// Ideia:
+//   - O valor do semáforo fica em um inteiro atômico de 32 bits.
+//   - sem_wait/sem_post NÃO fazem chamada de sistema quando não há disputa:
+//     basta um compare-and-swap atômico no contador.
+//   - Só quando o valor chega a 0 a thread "dorme" no kernel com FUTEX_WAIT,
+//     e o post só chama FUTEX_WAKE se souber que há alguém esperando.
+//
+// API (mesma semântica de <semaphore.h>, retornando 0 ou -1 + errno):
+//     fsem_init(&s, pshared, valor)   pshared != 0 → entre processos
+//     fsem_wait(&s)                   DOWN (P)
+//     fsem_trywait(&s)                DOWN sem bloquear (EAGAIN)
+//     fsem_timedwait(&s, &abs)        DOWN com prazo absoluto (CLOCK_REALTIME)
+//     fsem_post(&s)                   UP (V)
+//     fsem_getvalue(&s, &v)
+//     fsem_destroy(&s)
+//
+// Uso como substituto direto de sem_t:
+//     gcc -O2 -pthread -DUSE_FUTEX_SEM posix_sem_wait_post.c -o ...
+//   Com USE_FUTEX_SEM definido, este cabeçalho redefine sem_t/sem_init/
+//   sem_wait/... para as versões fsem_*, sem mexer no resto do código.
+//
+// Semáforo entre processos (pshared != 0):
+//   a estrutura precisa estar em memória compartilhada (mmap MAP_SHARED ou
+//   shm_open), exatamente como exige sem_init(&s, 1, v).
+// ============================================================================
+
+#ifndef FUTEX_SEM_H
+#define FUTEX_SEM_H
+
+#include <stdatomic.h>         // atomic_uint, atomic_compare_exchange_*
+#include <stdint.h>            // uint32_t
+#include <errno.h>             // EAGAIN, EINTR, ETIMEDOUT, EOVERFLOW
+#include <limits.h>            // INT_MAX
+#include <time.h>              // struct timespec
+#include <unistd.h>            // sysconf
+#include <sys/syscall.h>       // SYS_futex
+#include <linux/futex.h>       // FUTEX_WAIT, FUTEX_WAKE, FUTEX_PRIVATE_FLAG
+
+// <unistd.h> só declara syscall() com _GNU_SOURCE/_DEFAULT_SOURCE; as demos
+// usam _POSIX_C_SOURCE, então declaramos aqui (mesma assinatura da glibc).
+extern long syscall(long sysno, ...);
+
+#define FSEM_VALUE_MAX  INT_MAX   // mesmo limite de SEM_VALUE_MAX na glibc
+#define FSEM_SPIN       100       // tentativas em espaço de usuário antes de dormir
+
+// Dica para a CPU de que estamos em espera ativa (libera recursos do core SMT irmão)
+#if defined(__x86_64__) || defined(__i386__)
+#define cpu_relax()     __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define cpu_relax()     __asm__ volatile("yield" ::: "memory")
+#else
+#define cpu_relax()     ((void)0)
+#endif
+
+typedef struct {
+    atomic_uint valor;       // permissões disponíveis (a "palavra" do futex)
+    atomic_uint esperando;   // threads bloqueadas (ou prestes a bloquear)
+    int         privado;     // FUTEX_PRIVATE_FLAG (threads) ou 0 (processos)
+} fsem_t;
+
+// ----------------------------------------------------------------------------
+// Chamadas futex cruas (a glibc não exporta wrapper para futex)
+// ----------------------------------------------------------------------------
+// futex_wait: dorme SE *uaddr ainda valer 'esperado' (o kernel confere de forma
+// atômica, então um post que aconteceu "no meio do caminho" não se perde).
+// abs != NULL → prazo absoluto no relógio indicado por 'clock_flag'.
+static inline int futex_wait(atomic_uint *uaddr, uint32_t esperado,
+                             const struct timespec *abs, int clock_flag,
+                             int privado) {
+    if (abs == NULL)
+        return (int)syscall(SYS_futex, uaddr, FUTEX_WAIT | privado,
+                            esperado, NULL, NULL, 0);
+    // FUTEX_WAIT_BITSET é a única variante que aceita prazo ABSOLUTO.
+    return (int)syscall(SYS_futex, uaddr, FUTEX_WAIT_BITSET | privado | clock_flag,
+                        esperado, abs, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+// futex_wake: acorda até 'n' threads dormindo em uaddr.
+static inline int futex_wake(atomic_uint *uaddr, int n, int privado) {
+    return (int)syscall(SYS_futex, uaddr, FUTEX_WAKE | privado, n, NULL, NULL, 0);
+}
+
+// ----------------------------------------------------------------------------
+// Inicializa / destrói
+// ----------------------------------------------------------------------------
+static inline int fsem_init(fsem_t *s, int pshared, unsigned int valor) {
+    if (valor > FSEM_VALUE_MAX) {
+        errno = EINVAL;
+        return -1;
+    }
+    atomic_init(&s->valor, valor);
+    atomic_init(&s->esperando, 0);
+    // Futex "privado" é mais barato: o kernel não precisa resolver o endereço
+    // físico da página. Só vale quando todos os usuários estão no MESMO processo.
+    s->privado = pshared ? 0 : FUTEX_PRIVATE_FLAG;
+    return 0;
+}
+
+static inline int fsem_destroy(fsem_t *s) {
+    (void)s;                 // nada a liberar: não há recurso no kernel
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Caminho rápido: tenta decrementar sem bloquear
+// ----------------------------------------------------------------------------
+static inline int fsem_trywait(fsem_t *s) {
+    unsigned int v = atomic_load_explicit(&s->valor, memory_order_relaxed);
+    while (v > 0) {
+        // Sucesso → adquirimos uma permissão (acquire: enxerga o que o post publicou)
+        if (atomic_compare_exchange_weak_explicit(&s->valor, &v, v - 1,
+                                                  memory_order_acquire,
+                                                  memory_order_relaxed))
+            return 0;
+        // Falhou: 'v' foi recarregado com o valor atual; tenta de novo.
+    }
+    errno = EAGAIN;
+    return -1;
+}
+
+// ----------------------------------------------------------------------------
+// Caminho lento comum a wait/timedwait
+// ----------------------------------------------------------------------------
+static inline int fsem_wait_lento(fsem_t *s, const struct timespec *abs) {
+    // Espera ativa curta: em handoffs rápidos o post costuma chegar antes de
+    // valer a pena pagar a ida e volta ao kernel. Com uma única CPU, quem vai
+    // dar o post nem consegue rodar enquanto giramos — então não giramos.
+    // Várias threads podem chegar aqui juntas: atômico, e todas calculam o
+    // mesmo valor, então a corrida na primeira vez é inofensiva.
+    static atomic_int spin_cache = -1;
+    int spin = atomic_load_explicit(&spin_cache, memory_order_relaxed);
+    if (spin < 0) {
+        spin = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? FSEM_SPIN : 0;
+        atomic_store_explicit(&spin_cache, spin, memory_order_relaxed);
+    }
+    for (int i = 0; i < spin; i++) {
+        if (fsem_trywait(s) == 0)
+            return 0;
+        cpu_relax();
+    }
+
+    // Anuncia que vamos dormir ANTES de reler o valor (seq_cst). O post faz o
+    // inverso: incrementa o valor e depois lê 'esperando'. Assim, ou o post nos
+    // vê e chama FUTEX_WAKE, ou nós vemos o valor > 0 — nunca os dois perdem.
+    atomic_fetch_add(&s->esperando, 1);
+    int rc = 0;
+    for (;;) {
+        if (fsem_trywait(s) == 0)
+            break;
+        int r = futex_wait(&s->valor, 0, abs, FUTEX_CLOCK_REALTIME, s->privado);
+        if (r == -1 && errno == ETIMEDOUT) { rc = -1; break; }
+        if (r == -1 && errno == EINTR)     { rc = -1; break; }  // como sem_wait
+        // r == 0 (acordado) ou EAGAIN (valor mudou antes de dormir): reavalia.
+    }
+    atomic_fetch_sub(&s->esperando, 1);
+    return rc;
+}
+
+static inline int fsem_wait(fsem_t *s) {
+    if (fsem_trywait(s) == 0)            // sem disputa: nenhuma syscall
+        return 0;
+    return fsem_wait_lento(s, NULL);
+}
+
+// abs: prazo ABSOLUTO em CLOCK_REALTIME, igual a sem_timedwait().
+static inline int fsem_timedwait(fsem_t *s, const struct timespec *abs) {
+    if (fsem_trywait(s) == 0)
+        return 0;
+    if (abs->tv_nsec < 0 || abs->tv_nsec >= 1000000000L) {
+        errno = EINVAL;
+        return -1;
+    }
+    return fsem_wait_lento(s, abs);
+}
+
+// ----------------------------------------------------------------------------
+// UP (V): incrementa e acorda UM esperando, se houver
+// ----------------------------------------------------------------------------
+static inline int fsem_post(fsem_t *s) {
+    unsigned int v = atomic_load_explicit(&s->valor, memory_order_relaxed);
+    do {
+        if (v >= FSEM_VALUE_MAX) {
+            errno = EOVERFLOW;
+            return -1;
+        }
+    } while (!atomic_compare_exchange_weak(&s->valor, &v, v + 1));  // seq_cst
+
+    // Só entra no kernel se alguém anunciou que vai dormir.
+    if (atomic_load(&s->esperando) > 0)
+        futex_wake(&s->valor, 1, s->privado);
+    return 0;
+}
+
+static inline int fsem_getvalue(fsem_t *s, int *sval) {
+    *sval = (int)atomic_load_explicit(&s->valor, memory_order_relaxed);
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Substituição direta de <semaphore.h> (compile com -DUSE_FUTEX_SEM)
+// ----------------------------------------------------------------------------
+#ifdef USE_FUTEX_SEM
+#include <semaphore.h>       // inclui ANTES dos #define para não renomear o original
+#define sem_t          fsem_t
+#define sem_init       fsem_init
+#define sem_destroy    fsem_destroy
+#define sem_wait       fsem_wait
+#define sem_trywait    fsem_trywait
+#define sem_timedwait  fsem_timedwait
+#define sem_post       fsem_post
+#define sem_getvalue   fsem_getvalue
+#endif
+
+#endif // FUTEX_SEM_H
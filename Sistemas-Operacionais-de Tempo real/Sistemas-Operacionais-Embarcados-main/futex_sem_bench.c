@@ -0,0 +1,181 @@
+// ============================================================================
+// futex_sem_bench.c
+// Compara o semáforo futex em espaço de usuário (futex_sem.h) com o sem_t da
+// glibc em dois cenários:
+//
+//   1) VAZÃO: T threads fazem wait/post em laço sobre UM semáforo de
+//      capacidade CAP, durante um intervalo fixo. Mede operações/segundo.
+//      Com CAP >= T não há disputa (caminho rápido); com CAP < T as threads
+//      passam a bloquear e o custo do caminho lento aparece.
+//
+//   2) HANDOFF: ping-pong entre duas threads (ou dois processos, no modo
+//      pshared) usando dois semáforos com valor inicial 0. Mede a latência
+//      de post → wait acordado (metade de uma ida e volta).
+// ----------------------------------------------------------------------------
+// Compilar:   gcc -O2 -pthread futex_sem_bench.c -o futex_sem_bench
+// Executar:   ./futex_sem_bench            (1..nproc threads, CAP = 1,2,4,8)
+//             ./futex_sem_bench 8          (força até 8 threads)
+// ============================================================================
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>     // mmap (memória compartilhada para o modo pshared)
+#include <sys/wait.h>     // waitpid
+
+#include "futex_sem.h"
+
+// ----------------------------------------------------------------------------
+// Configuração do experimento
+// ----------------------------------------------------------------------------
+#define DURACAO_MS      300       // duração de cada medição de vazão
+#define HANDOFF_ITERS   100000    // idas e voltas no ping-pong
+static const int CAPS[] = { 1, 2, 4, 8 };
+#define NCAPS ((int)(sizeof(CAPS) / sizeof(CAPS[0])))
+
+static inline long long agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// ----------------------------------------------------------------------------
+// Gera as funções de benchmark para uma implementação de semáforo.
+// Usamos macro (e não ponteiros de função) para que as duas versões sejam
+// compiladas com chamadas diretas — inclusive o inline do caminho rápido.
+// ----------------------------------------------------------------------------
+#define DEFINE_BENCH(nome, TIPO, INIT, WAIT, POST, DESTROY)                     \
+                                                                                \
+typedef struct {                                                                \
+    TIPO *sem;                                                                  \
+    atomic_int *parar;                                                          \
+    long long ops;                                                              \
+} nome##_vazao_arg;                                                             \
+                                                                                \
+static void *nome##_vazao_worker(void *p) {                                     \
+    nome##_vazao_arg *a = p;                                                    \
+    long long ops = 0;                                                          \
+    while (!atomic_load_explicit(a->parar, memory_order_relaxed)) {             \
+        WAIT(a->sem);                                                           \
+        /* "seção crítica" vazia: medimos só o custo do semáforo */             \
+        POST(a->sem);                                                           \
+        ops++;                                                                  \
+    }                                                                           \
+    a->ops = ops;                                                               \
+    return NULL;                                                                \
+}                                                                               \
+                                                                                \
+/* Retorna operações (wait+post) por segundo, somando todas as threads. */     \
+static double nome##_vazao(int nthreads, int cap) {                             \
+    TIPO sem;                                                                   \
+    atomic_int parar = 0;                                                       \
+    INIT(&sem, 0, cap);                                                         \
+    pthread_t th[nthreads];                                                     \
+    nome##_vazao_arg args[nthreads];                                            \
+    for (int i = 0; i < nthreads; i++) {                                        \
+        args[i] = (nome##_vazao_arg){ .sem = &sem, .parar = &parar };           \
+        pthread_create(&th[i], NULL, nome##_vazao_worker, &args[i]);            \
+    }                                                                           \
+    long long t0 = agora_ns();                                                  \
+    struct timespec d = { DURACAO_MS / 1000, (DURACAO_MS % 1000) * 1000000L };  \
+    nanosleep(&d, NULL);                                                        \
+    atomic_store(&parar, 1);                                                    \
+    long long total = 0;                                                        \
+    for (int i = 0; i < nthreads; i++) {                                        \
+        pthread_join(th[i], NULL);                                              \
+        total += args[i].ops;                                                   \
+    }                                                                           \
+    double seg = (agora_ns() - t0) / 1e9;                                       \
+    DESTROY(&sem);                                                              \
+    return total / seg;                                                         \
+}                                                                               \
+                                                                                \
+/* Par de semáforos do ping-pong (pode morar em memória compartilhada). */     \
+typedef struct {                                                                \
+    TIPO ping, pong;                                                            \
+} nome##_par;                                                                   \
+                                                                                \
+static void nome##_eco(nome##_par *p) {                                         \
+    for (int i = 0; i < HANDOFF_ITERS; i++) {                                   \
+        WAIT(&p->ping);                                                         \
+        POST(&p->pong);                                                         \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void *nome##_eco_thread(void *p) {                                       \
+    nome##_eco(p);                                                              \
+    return NULL;                                                                \
+}                                                                               \
+                                                                                \
+/* Latência média de handoff (ns). pshared = 1 → eco roda em processo filho. */ \
+static double nome##_handoff(int pshared) {                                     \
+    nome##_par *p = mmap(NULL, sizeof(*p), PROT_READ | PROT_WRITE,              \
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);                    \
+    if (p == MAP_FAILED) { perror("mmap"); exit(1); }                           \
+    INIT(&p->ping, pshared, 0);                                                 \
+    INIT(&p->pong, pshared, 0);                                                 \
+    pthread_t th;                                                               \
+    pid_t pid = -1;                                                             \
+    if (pshared) {                                                              \
+        pid = fork();                                                           \
+        if (pid < 0) { perror("fork"); exit(1); }                               \
+        if (pid == 0) { nome##_eco(p); _exit(0); }                              \
+    } else {                                                                    \
+        pthread_create(&th, NULL, nome##_eco_thread, p);                        \
+    }                                                                           \
+    long long t0 = agora_ns();                                                  \
+    for (int i = 0; i < HANDOFF_ITERS; i++) {                                   \
+        POST(&p->ping);                                                         \
+        WAIT(&p->pong);                                                         \
+    }                                                                           \
+    long long dt = agora_ns() - t0;                                             \
+    if (pshared) waitpid(pid, NULL, 0); else pthread_join(th, NULL);            \
+    DESTROY(&p->ping);                                                          \
+    DESTROY(&p->pong);                                                          \
+    munmap(p, sizeof(*p));                                                      \
+    return dt / (2.0 * HANDOFF_ITERS);  /* duas transferências por volta */     \
+}
+
+DEFINE_BENCH(posix, sem_t,  sem_init,  sem_wait,  sem_post,  sem_destroy)
+DEFINE_BENCH(futex, fsem_t, fsem_init, fsem_wait, fsem_post, fsem_destroy)
+
+// ----------------------------------------------------------------------------
+// Programa principal
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    int max_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (argc > 1)
+        max_threads = atoi(argv[1]);
+    if (max_threads < 1)
+        max_threads = 1;
+
+    printf("=== Semáforo futex (fsem_t) x glibc (sem_t) ===\n");
+    printf("Threads: 1..%d | Duração por ponto: %d ms\n\n", max_threads, DURACAO_MS);
+
+    // ---------------------------- Vazão ------------------------------------
+    printf("1) Vazão wait+post (Mops/s)\n");
+    printf("%7s %5s %10s %10s %8s\n", "threads", "CAP", "sem_t", "fsem_t", "ganho");
+    for (int t = 1; t <= max_threads; t++) {
+        for (int c = 0; c < NCAPS; c++) {
+            double a = posix_vazao(t, CAPS[c]);
+            double b = futex_vazao(t, CAPS[c]);
+            printf("%7d %5d %10.2f %10.2f %7.2fx\n",
+                   t, CAPS[c], a / 1e6, b / 1e6, b / a);
+        }
+    }
+
+    // --------------------------- Handoff -----------------------------------
+    printf("\n2) Latência de handoff post → wait (ns, média de %d voltas)\n",
+           HANDOFF_ITERS);
+    printf("%-22s %10s %10s\n", "cenário", "sem_t", "fsem_t");
+    printf("%-22s %10.0f %10.0f\n", "threads (privado)", posix_handoff(0), futex_handoff(0));
+    printf("%-22s %10.0f %10.0f\n", "processos (pshared)", posix_handoff(1), futex_handoff(1));
+
+    return 0;
+}
@@ -0,0 +1,402 @@
+/*
+ * lockprof.c
+ * Perfilador de disputa de locks para as demos com pthreads.
+ *
+ * Ideia:
+ *  - Usamos a opção --wrap do linker: toda chamada a pthread_mutex_lock() no
+ *    programa passa a chamar __wrap_pthread_mutex_lock() (definida aqui), que
+ *    mede o tempo e chama a função original via __real_pthread_mutex_lock().
+ *  - Funções interceptadas: pthread_mutex_lock/unlock, pthread_cond_wait,
+ *    sem_wait/sem_post.
+ *  - Para cada "sítio" (endereço do lock + endereço de quem chamou) guardamos:
+ *      aquisições, quantas foram disputadas (o lock estava ocupado),
+ *      tempo esperando para adquirir e tempo segurando o lock,
+ *    em histogramas log2 POR THREAD (sem lock nenhum no caminho de medição).
+ *  - No exit() os histogramas de todas as threads são somados e impressos em
+ *    um ranking dos locks mais "quentes" (maior tempo total de espera).
+ *
+ * Ativação: só mede se a variável de ambiente LOCKPROF estiver definida.
+ *   Desligado, cada wrapper custa um teste de flag antes da chamada original.
+ *   LOCKPROF_TOP=N limita o ranking às N primeiras linhas (padrão 10).
+ *
+ * Como compilar (exemplo com mutex_demo.c):
+ *   gcc -O2 -pthread "Coordenação entre Tarefas/mutex_demo.c" lockprof.c -o mutex_demo_prof \
+ *       -Wl,--wrap=pthread_mutex_lock,--wrap=pthread_mutex_unlock \
+ *       -Wl,--wrap=pthread_cond_wait,--wrap=sem_wait,--wrap=sem_post -ldl
+ *   (o mesmo vale para conta_monitor.c e posix_sem_wait_post.c)
+ *
+ * Como executar:
+ *   LOCKPROF=1 ./mutex_demo_prof
+ *   (programas que não terminam sozinhos: o relatório sai também no Ctrl+C)
+ *
+ * Observação:
+ *   - O sítio é impresso como função+deslocamento quando o símbolo é visível
+ *     (compile com -rdynamic para ver também funções não-static) e sempre como
+ *     deslocamento no binário, que pode ser traduzido com:
+ *       addr2line -f -e ./mutex_demo_prof 0x<deslocamento>
+ *   - Com -DUSE_FUTEX_SEM o semáforo é inline (futex_sem.h) e não é medido.
+ */
+
+#define _GNU_SOURCE           // dladdr
+#include <pthread.h>          // pthread_mutex_*, pthread_cond_wait
+#include <semaphore.h>        // sem_wait, sem_trywait, sem_post
+#include <stdio.h>            // fprintf
+#include <stdlib.h>           // getenv, calloc, qsort, atexit
+#include <string.h>           // memset
+#include <errno.h>            // EBUSY, EAGAIN
+#include <time.h>             // clock_gettime
+#include <dlfcn.h>            // dladdr
+#include <signal.h>           // sigaction (relatório também no Ctrl+C)
+
+// ----------------------------------------------------------------------------
+// Funções originais (resolvidas pelo linker por causa do --wrap)
+// ----------------------------------------------------------------------------
+int __real_pthread_mutex_lock(pthread_mutex_t *m);
+int __real_pthread_mutex_unlock(pthread_mutex_t *m);
+int __real_pthread_cond_wait(pthread_cond_t *c, pthread_mutex_t *m);
+int __real_sem_wait(sem_t *s);
+int __real_sem_post(sem_t *s);
+
+// ----------------------------------------------------------------------------
+// Estruturas de medição
+// ----------------------------------------------------------------------------
+#define LP_SITIOS    256   // sítios distintos por thread (tabela hash)
+#define LP_PILHA     16    // locks segurados ao mesmo tempo por thread
+#define LP_BUCKETS   40    // histograma log2 em ns: bucket b = [2^(b-1), 2^b)
+
+enum { LP_MUTEX, LP_COND, LP_SEM };
+static const char *lp_tipo_nome[] = { "mutex", "cond", "sem" };
+
+typedef struct {
+    const void *lock;              // endereço do mutex/cond/sem (NULL = vazio)
+    const void *sitio;             // endereço de retorno de quem chamou
+    int tipo;
+    unsigned long aquisicoes;
+    unsigned long disputadas;      // lock ocupado no momento do pedido
+    unsigned long long espera_ns, segura_ns, espera_max, segura_max;
+    unsigned long hist_espera[LP_BUCKETS];
+    unsigned long hist_segura[LP_BUCKETS];
+    int threads;                   // usado só no relatório (threads distintas)
+} LpSitio;
+
+typedef struct {
+    const void *lock;
+    LpSitio *sitio;                // entrada da aquisição (recebe o tempo segurado)
+    long long t_aquis;
+} LpSegurado;
+
+typedef struct LpThread {
+    LpSitio tab[LP_SITIOS];
+    LpSegurado pilha[LP_PILHA];
+    int topo;
+    unsigned long descartados;     // tabela cheia
+    struct LpThread *prox;
+} LpThread;
+
+static int lp_ativo;                               // lido em todo wrapper
+static __thread LpThread *lp_eu;                   // tabela da thread atual
+static LpThread *lp_todas;                         // lista global (para o relatório)
+static pthread_mutex_t lp_lista_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+static inline long long lp_agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline int lp_bucket(unsigned long long ns) {
+    int b = ns ? 64 - __builtin_clzll(ns) : 0;
+    return b < LP_BUCKETS ? b : LP_BUCKETS - 1;
+}
+
+static LpThread *lp_thread(void) {
+    if (lp_eu == NULL) {
+        // Primeira medição desta thread: aloca e registra a tabela. A tabela
+        // NÃO é liberada quando a thread termina — o relatório roda no exit().
+        lp_eu = calloc(1, sizeof(LpThread));
+        if (lp_eu == NULL)
+            return NULL;
+        __real_pthread_mutex_lock(&lp_lista_mtx);
+        lp_eu->prox = lp_todas;
+        lp_todas = lp_eu;
+        __real_pthread_mutex_unlock(&lp_lista_mtx);
+    }
+    return lp_eu;
+}
+
+static LpSitio *lp_sitio(LpThread *t, const void *lock, const void *sitio, int tipo) {
+    unsigned long h = ((unsigned long)lock >> 4) ^ ((unsigned long)sitio * 0x9E3779B97F4A7C15UL);
+    for (int i = 0; i < LP_SITIOS; i++) {
+        LpSitio *s = &t->tab[(h + i) & (LP_SITIOS - 1)];
+        if (s->lock == lock && s->sitio == sitio)
+            return s;
+        if (s->lock == NULL) {
+            s->lock = lock;
+            s->sitio = sitio;
+            s->tipo = tipo;
+            return s;
+        }
+    }
+    t->descartados++;
+    return NULL;
+}
+
+static void lp_registra_espera(LpSitio *s, int disputada, unsigned long long ns) {
+    s->aquisicoes++;
+    s->disputadas += disputada;
+    s->espera_ns += ns;
+    if (ns > s->espera_max) s->espera_max = ns;
+    s->hist_espera[lp_bucket(ns)]++;
+}
+
+static void lp_registra_segura(LpSitio *s, unsigned long long ns) {
+    s->segura_ns += ns;
+    if (ns > s->segura_max) s->segura_max = ns;
+    s->hist_segura[lp_bucket(ns)]++;
+}
+
+static void lp_empilha(LpThread *t, const void *lock, LpSitio *s, long long agora) {
+    if (t->topo < LP_PILHA)
+        t->pilha[t->topo++] = (LpSegurado){ lock, s, agora };
+}
+
+// Retira 'lock' da pilha de locks segurados e contabiliza o tempo segurado.
+static void lp_desempilha(LpThread *t, const void *lock, long long agora) {
+    for (int i = t->topo - 1; i >= 0; i--) {
+        if (t->pilha[i].lock == lock) {
+            if (t->pilha[i].sitio)
+                lp_registra_segura(t->pilha[i].sitio, agora - t->pilha[i].t_aquis);
+            t->pilha[i] = t->pilha[--t->topo];
+            return;
+        }
+    }
+    // Não achou: ex.: sem_post de um semáforo usado como sinal entre threads.
+}
+
+// ----------------------------------------------------------------------------
+// Wrappers
+// ----------------------------------------------------------------------------
+int __wrap_pthread_mutex_lock(pthread_mutex_t *m) {
+    if (!lp_ativo)
+        return __real_pthread_mutex_lock(m);
+
+    const void *sitio = __builtin_return_address(0);
+    long long t0 = lp_agora();
+    // trylock primeiro: se já conseguir, a aquisição NÃO foi disputada.
+    int rc = pthread_mutex_trylock(m);
+    int disputada = (rc == EBUSY);
+    if (disputada)
+        rc = __real_pthread_mutex_lock(m);
+    long long t1 = lp_agora();
+
+    LpThread *t = lp_thread();
+    if (rc == 0 && t) {
+        LpSitio *s = lp_sitio(t, m, sitio, LP_MUTEX);
+        if (s) lp_registra_espera(s, disputada, t1 - t0);
+        lp_empilha(t, m, s, t1);
+    }
+    return rc;
+}
+
+int __wrap_pthread_mutex_unlock(pthread_mutex_t *m) {
+    if (lp_ativo && lp_eu)
+        lp_desempilha(lp_eu, m, lp_agora());
+    return __real_pthread_mutex_unlock(m);
+}
+
+int __wrap_pthread_cond_wait(pthread_cond_t *c, pthread_mutex_t *m) {
+    if (!lp_ativo)
+        return __real_pthread_cond_wait(c, m);
+
+    const void *sitio = __builtin_return_address(0);
+    LpThread *t = lp_thread();
+    long long t0 = lp_agora();
+
+    // O mutex é liberado durante a espera: fecha o intervalo "segurando"...
+    LpSitio *dono = NULL;
+    if (t) {
+        for (int i = t->topo - 1; i >= 0; i--)
+            if (t->pilha[i].lock == m) { dono = t->pilha[i].sitio; break; }
+        lp_desempilha(t, m, t0);
+    }
+
+    int rc = __real_pthread_cond_wait(c, m);
+    long long t1 = lp_agora();
+
+    // ...conta a espera na condição (toda espera em cond é "disputada")...
+    if (t) {
+        LpSitio *s = lp_sitio(t, c, sitio, LP_COND);
+        if (s) lp_registra_espera(s, 1, t1 - t0);
+        // ...e reabre o intervalo do mutex, creditado ao sítio que o adquiriu.
+        lp_empilha(t, m, dono, t1);
+    }
+    return rc;
+}
+
+int __wrap_sem_wait(sem_t *sem) {
+    if (!lp_ativo)
+        return __real_sem_wait(sem);
+
+    const void *sitio = __builtin_return_address(0);
+    long long t0 = lp_agora();
+    int rc = sem_trywait(sem);
+    int disputada = (rc != 0 && errno == EAGAIN);
+    if (disputada)
+        rc = __real_sem_wait(sem);
+    long long t1 = lp_agora();
+
+    LpThread *t = lp_thread();
+    if (rc == 0 && t) {
+        LpSitio *s = lp_sitio(t, sem, sitio, LP_SEM);
+        if (s) lp_registra_espera(s, disputada, t1 - t0);
+        lp_empilha(t, sem, s, t1);
+    }
+    return rc;
+}
+
+int __wrap_sem_post(sem_t *sem) {
+    if (lp_ativo && lp_eu)
+        lp_desempilha(lp_eu, sem, lp_agora());
+    return __real_sem_post(sem);
+}
+
+// ----------------------------------------------------------------------------
+// Relatório no exit()
+// ----------------------------------------------------------------------------
+static int lp_cmp(const void *a, const void *b) {
+    const LpSitio *x = a, *y = b;
+    if (x->espera_ns != y->espera_ns)
+        return x->espera_ns < y->espera_ns ? 1 : -1;
+    return (x->disputadas < y->disputadas) - (x->disputadas > y->disputadas);
+}
+
+// Limite superior do bucket onde cai o percentil p do histograma
+// (nunca maior que o máximo observado).
+static unsigned long long lp_percentil(const unsigned long *h, unsigned long n,
+                                       double p, unsigned long long max) {
+    unsigned long alvo = (unsigned long)(p * n), acc = 0;
+    for (int b = 0; b < LP_BUCKETS; b++) {
+        acc += h[b];
+        if (acc > alvo) {
+            unsigned long long lim = b ? 1ULL << b : 0;
+            return lim < max ? lim : max;
+        }
+    }
+    return max;
+}
+
+static const char *lp_nome_sitio(const void *sitio, char *buf, size_t n) {
+    Dl_info info;
+    if (dladdr(sitio, &info) && info.dli_fbase) {
+        unsigned long off = (unsigned long)sitio - (unsigned long)info.dli_fbase;
+        if (info.dli_sname)
+            snprintf(buf, n, "%s+0x%lx (0x%lx)", info.dli_sname,
+                     (unsigned long)sitio - (unsigned long)info.dli_saddr, off);
+        else
+            snprintf(buf, n, "0x%lx", off);
+    } else {
+        snprintf(buf, n, "%p", sitio);
+    }
+    return buf;
+}
+
+static void lp_relatorio(void) {
+    if (!lp_ativo)
+        return;                    // já impresso (sinal seguido de exit)
+    lp_ativo = 0;
+
+    // Soma as tabelas de todas as threads por (lock, sítio).
+    int cap = 1024, n = 0;
+    LpSitio *todos = calloc(cap, sizeof(LpSitio));
+    unsigned long descartados = 0;
+    int nthreads = 0;
+    if (todos == NULL)
+        return;
+    for (LpThread *t = lp_todas; t; t = t->prox) {
+        nthreads++;
+        descartados += t->descartados;
+        for (int i = 0; i < LP_SITIOS; i++) {
+            LpSitio *s = &t->tab[i];
+            if (s->lock == NULL)
+                continue;
+            int j;
+            for (j = 0; j < n; j++)
+                if (todos[j].lock == s->lock && todos[j].sitio == s->sitio)
+                    break;
+            if (j == n) {
+                if (n == cap) {
+                    LpSitio *novo = realloc(todos, 2 * cap * sizeof(LpSitio));
+                    if (novo == NULL) break;
+                    memset(novo + cap, 0, cap * sizeof(LpSitio));
+                    todos = novo;
+                    cap *= 2;
+                }
+                todos[n].lock = s->lock;
+                todos[n].sitio = s->sitio;
+                todos[n].tipo = s->tipo;
+                n++;
+            }
+            LpSitio *d = &todos[j];
+            d->threads++;
+            d->aquisicoes += s->aquisicoes;
+            d->disputadas += s->disputadas;
+            d->espera_ns += s->espera_ns;
+            d->segura_ns += s->segura_ns;
+            if (s->espera_max > d->espera_max) d->espera_max = s->espera_max;
+            if (s->segura_max > d->segura_max) d->segura_max = s->segura_max;
+            for (int b = 0; b < LP_BUCKETS; b++) {
+                d->hist_espera[b] += s->hist_espera[b];
+                d->hist_segura[b] += s->hist_segura[b];
+            }
+        }
+    }
+    qsort(todos, n, sizeof(LpSitio), lp_cmp);
+
+    int top = 10;
+    const char *env = getenv("LOCKPROF_TOP");
+    if (env && atoi(env) > 0)
+        top = atoi(env);
+
+    fprintf(stderr, "\n=== lockprof: %d sítios, %d threads (ranking por tempo total de espera) ===\n",
+            n, nthreads);
+    fprintf(stderr, "%3s %-5s %-14s %9s %7s %11s %9s %9s %11s %9s %3s  %s\n",
+            "#", "tipo", "lock", "aquis", "disp%", "espera_ms", "esp_p99", "esp_max",
+            "segura_ms", "seg_max", "thr", "sítio");
+    for (int i = 0; i < n && i < top; i++) {
+        LpSitio *s = &todos[i];
+        char nome[160];
+        fprintf(stderr, "%3d %-5s %-14p %9lu %6.1f%% %11.3f %7.1fus %7.1fus %11.3f %7.1fus %3d  %s\n",
+                i + 1, lp_tipo_nome[s->tipo], s->lock, s->aquisicoes,
+                s->aquisicoes ? 100.0 * s->disputadas / s->aquisicoes : 0.0,
+                s->espera_ns / 1e6,
+                lp_percentil(s->hist_espera, s->aquisicoes, 0.99, s->espera_max) / 1e3,
+                s->espera_max / 1e3,
+                s->segura_ns / 1e6, s->segura_max / 1e3, s->threads,
+                lp_nome_sitio(s->sitio, nome, sizeof(nome)));
+    }
+    if (descartados)
+        fprintf(stderr, "(aviso: %lu aquisições sem registro — tabela por thread cheia)\n",
+                descartados);
+    free(todos);
+}
+
+// Programas que nunca terminam sozinhos (ou que ficam bloqueados, como o
+// conta_monitor quando o saldo não basta) são encerrados com Ctrl+C: imprimimos
+// o relatório antes de deixar o sinal seguir seu efeito padrão. Não é
+// async-signal-safe, mas o programa está morrendo de qualquer forma.
+static void lp_sinal(int sig) {
+    lp_relatorio();
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+__attribute__((constructor))
+static void lp_inicia(void) {
+    if (getenv("LOCKPROF") == NULL)
+        return;
+    lp_ativo = 1;
+    atexit(lp_relatorio);
+    struct sigaction sa = { .sa_handler = lp_sinal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+}
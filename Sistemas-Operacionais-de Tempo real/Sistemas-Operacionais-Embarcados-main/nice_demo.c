@@ -0,0 +1,263 @@
+/*
+ * Demonstração: Prioridade dinâmica com nice (SCHED_OTHER / CFS-EEVDF)
+ *
+ * Ideia:
+ *  - O PAI cria N processos FILHOS CPU-bound, todos presos no MESMO core, cada um
+ *    com um valor de nice. Cada FILHO só incrementa um contador.
+ *  - Os contadores ficam numa região MAP_SHARED, um por linha de cache (padding de
+ *    64 bytes) para que um filho não "suje" a linha do outro (false sharing).
+ *  - O PAI amostra a região a cada segundo e calcula a fatia de CPU de cada filho:
+ *      pela contagem de iterações e pelo tempo de CPU (CLOCK_PROCESS_CPUTIME_ID
+ *      publicado pelo próprio filho).
+ *  - A fatia medida é comparada com a teórica do escalonador: cada nice tem um
+ *    PESO (tabela sched_prio_to_weight do kernel; nice 0 = 1024, cada nível
+ *    ≈ 1,25x) e a fatia esperada é peso / soma dos pesos.
+ *
+ * Como compilar:
+ *   gcc -O2 nice_demo.c -o nice_demo
+ *
+ * Como executar:
+ *   sudo ./nice_demo                 (padrão: nice -5 e +15)
+ *   ./nice_demo 0 5 10               (um filho por valor de nice)
+ *   ./nice_demo -c 2 -d 10 0 0 19    (core 2, 10 s de medição)
+ *   sudo ./nice_demo -d 10 -- -5 0 5 (nice negativo: "--" separa das opções)
+ *
+ * Observação:
+ *   - Nice negativo exige sudo (ou CAP_SYS_NICE). Sem permissão o filho avisa e
+ *     fica com o nice que conseguir; a fatia teórica usa o nice REAL (getpriority).
+ *   - Para a comparação valer, nada mais deve estar rodando no core escolhido.
+ */
+
+#define _GNU_SOURCE           // sched_setaffinity, CPU_SET
+#include <stdio.h>           // printf, perror
+#include <stdlib.h>          // atoi, exit
+#include <string.h>          // strerror
+#include <errno.h>           // errno
+#include <unistd.h>          // fork, pipe, read, getopt
+#include <sched.h>           // sched_setaffinity, cpu_set_t
+#include <signal.h>          // kill
+#include <stdatomic.h>       // contadores compartilhados
+#include <sys/mman.h>        // mmap (MAP_SHARED)
+#include <sys/resource.h>    // setpriority, getpriority
+#include <sys/wait.h>        // waitpid
+#include <time.h>            // clock_gettime, nanosleep
+
+#define MAX_FILHOS  16
+
+// Pesos do CFS/EEVDF por nice (-20..19), kernel/sched/core.c: sched_prio_to_weight.
+static const int PESO_NICE[40] = {
+ /* -20 */ 88761, 71755, 56483, 46273, 36291,
+ /* -15 */ 29154, 23254, 18705, 14949, 11916,
+ /* -10 */  9548,  7620,  6100,  4904,  3906,
+ /*  -5 */  3121,  2501,  1991,  1586,  1277,
+ /*   0 */  1024,   820,   655,   526,   423,
+ /*   5 */   335,   272,   215,   172,   137,
+ /*  10 */   110,    87,    70,    56,    45,
+ /*  15 */    36,    29,    23,    18,    15,
+};
+
+// ----------------------------------------------------------------------------
+// Região compartilhada: um contador por linha de cache
+// ----------------------------------------------------------------------------
+typedef struct {
+    _Alignas(64) atomic_ullong iter;   // iterações do filho
+    atomic_llong cpu_ns;               // CPU consumida pelo filho (ele mesmo publica)
+    atomic_int   nice_real;            // nice efetivo após setpriority
+} Contador;
+
+static long long ns_de(clockid_t relogio) {
+    struct timespec ts;
+    clock_gettime(relogio, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// ----------------------------------------------------------------------------
+// FILHO: fixa core + nice, espera a largada e gira para sempre
+// ----------------------------------------------------------------------------
+static void filho(Contador *c, int cpu, int nice_pedido, int fd_pronto, int fd_largada) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+        fprintf(stderr, "FILHO %d: sched_setaffinity: %s\n", getpid(), strerror(errno));
+
+    if (setpriority(PRIO_PROCESS, 0, nice_pedido) != 0)
+        fprintf(stderr, "FILHO %d: nice %d negado (%s) — precisa de sudo para nice < 0\n",
+                getpid(), nice_pedido, strerror(errno));
+    errno = 0;
+    int nice_real = getpriority(PRIO_PROCESS, 0);
+    atomic_store(&c->nice_real, errno == 0 ? nice_real : nice_pedido);
+
+    // Avisa o PAI que core e nice já estão valendo (1 byte por filho).
+    if (write(fd_pronto, "", 1) != 1)
+        fprintf(stderr, "FILHO %d: write pronto: %s\n", getpid(), strerror(errno));
+    close(fd_pronto);
+
+    // Largada: read() bloqueia até o PAI fechar a ponta de escrita do pipe.
+    char b;
+    while (read(fd_largada, &b, 1) > 0)
+        ;
+    close(fd_largada);
+
+    unsigned long long x = 0;
+    for (;;) {
+        x++;
+        atomic_store_explicit(&c->iter, x, memory_order_relaxed);
+        if ((x & 0xFFFFF) == 0)     // de vez em quando publica o tempo de CPU
+            atomic_store_explicit(&c->cpu_ns, ns_de(CLOCK_PROCESS_CPUTIME_ID),
+                                  memory_order_relaxed);
+    }
+}
+
+// "-5" é um nice, não uma opção: a lista de nices começa no primeiro inteiro.
+static int eh_inteiro(const char *s) {
+    char *fim;
+    errno = 0;
+    strtol(s, &fim, 10);
+    return *s != '\0' && *fim == '\0' && errno == 0;
+}
+
+int main(int argc, char **argv) {
+    int cpu = 0, duracao_s = 5, op;
+    // '+': para na primeira não-opção; o eh_inteiro para antes de um nice negativo
+    // (e "--" continua valendo para quem preferir ser explícito).
+    while (optind < argc && !eh_inteiro(argv[optind]) &&
+           (op = getopt(argc, argv, "+c:d:")) != -1) {
+        switch (op) {
+        case 'c': cpu = atoi(optarg); break;
+        case 'd': duracao_s = atoi(optarg); break;
+        default:
+            fprintf(stderr, "uso: %s [-c core] [-d segundos] [--] [nice1 nice2 ...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    int nices[MAX_FILHOS] = { -5, 15 };
+    int n = 2;
+    if (optind < argc) {
+        n = 0;
+        for (int i = optind; i < argc && n < MAX_FILHOS; i++) {
+            int v = atoi(argv[i]);
+            nices[n++] = v < -20 ? -20 : v > 19 ? 19 : v;
+        }
+    }
+    if (duracao_s < 1) duracao_s = 1;
+
+    Contador *cont = mmap(NULL, n * sizeof(Contador), PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (cont == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    int pronto[2], largada[2];
+    if (pipe(pronto) != 0 || pipe(largada) != 0) {
+        perror("pipe");
+        return 1;
+    }
+
+    pid_t pids[MAX_FILHOS];
+    for (int i = 0; i < n; i++) {
+        pids[i] = fork();
+        if (pids[i] < 0) {
+            perror("fork");
+            return 1;
+        }
+        if (pids[i] == 0) {
+            close(pronto[0]);
+            close(largada[1]);
+            filho(&cont[i], cpu, nices[i], pronto[1], largada[0]);
+        }
+    }
+    close(pronto[1]);
+    close(largada[0]);
+
+    // Espera todos publicarem core/nice e só então solta a largada.
+    // read() == 0: todos os filhos fecharam 'pronto' sem avisar (morreram).
+    for (int prontos = 0; prontos < n; ) {
+        char b[MAX_FILHOS];
+        ssize_t r = read(pronto[0], b, (size_t)(n - prontos));
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r <= 0) {
+            fprintf(stderr, "PAI: só %d de %d filhos ficaram prontos\n", prontos, n);
+            for (int i = 0; i < n; i++)
+                kill(pids[i], SIGKILL);
+            return 1;
+        }
+        prontos += (int)r;
+    }
+    close(pronto[0]);
+    close(largada[1]);
+
+    // Fatia teórica com base no nice REAL de cada filho.
+    double peso_total = 0, teorica[MAX_FILHOS];
+    int nice_real[MAX_FILHOS];
+    for (int i = 0; i < n; i++) {
+        nice_real[i] = atomic_load(&cont[i].nice_real);
+        peso_total += PESO_NICE[nice_real[i] + 20];
+    }
+    for (int i = 0; i < n; i++)
+        teorica[i] = 100.0 * PESO_NICE[nice_real[i] + 20] / peso_total;
+
+    printf("=== Fatia de CPU por nice (%d filhos no core %d, %d s) ===\n\n", n, cpu, duracao_s);
+    printf("%4s", "s");
+    for (int i = 0; i < n; i++)
+        printf("   nice %3d", nice_real[i]);
+    printf("   (fatia no segundo, pelas iterações)\n");
+
+    // Amostragem: a cada segundo, fatia de cada filho no intervalo.
+    unsigned long long it_ini[MAX_FILHOS], it_ant[MAX_FILHOS];
+    long long cpu_ini[MAX_FILHOS];
+    for (int i = 0; i < n; i++) {
+        it_ini[i] = it_ant[i] = atomic_load(&cont[i].iter);
+        cpu_ini[i] = atomic_load(&cont[i].cpu_ns);
+    }
+    long long t_ini = ns_de(CLOCK_MONOTONIC);
+    for (int s = 1; s <= duracao_s; s++) {
+        struct timespec um_s = { 1, 0 };
+        nanosleep(&um_s, NULL);
+        unsigned long long d[MAX_FILHOS], soma = 0;
+        for (int i = 0; i < n; i++) {
+            unsigned long long v = atomic_load(&cont[i].iter);
+            d[i] = v - it_ant[i];
+            it_ant[i] = v;
+            soma += d[i];
+        }
+        printf("%4d", s);
+        for (int i = 0; i < n; i++)
+            printf("   %7.1f%%", soma ? 100.0 * d[i] / soma : 0.0);
+        printf("\n");
+    }
+    long long t_fim = ns_de(CLOCK_MONOTONIC);
+
+    // Congela os contadores antes do resumo.
+    unsigned long long it_total[MAX_FILHOS], soma_it = 0;
+    long long cpu_total[MAX_FILHOS], soma_cpu = 0;
+    for (int i = 0; i < n; i++) {
+        it_total[i] = atomic_load(&cont[i].iter) - it_ini[i];
+        cpu_total[i] = atomic_load(&cont[i].cpu_ns) - cpu_ini[i];
+        soma_it += it_total[i];
+        soma_cpu += cpu_total[i];
+    }
+    for (int i = 0; i < n; i++) {
+        kill(pids[i], SIGKILL);
+        waitpid(pids[i], NULL, 0);
+    }
+
+    printf("\n=== Resumo ===\n");
+    printf("%6s %6s %10s %14s %14s %12s\n",
+           "nice", "peso", "teórica", "medida (iter)", "medida (CPU)", "erro (p.p.)");
+    for (int i = 0; i < n; i++) {
+        double por_iter = soma_it ? 100.0 * it_total[i] / soma_it : 0;
+        double por_cpu  = soma_cpu ? 100.0 * cpu_total[i] / soma_cpu : 0;
+        printf("%6d %6d %9.1f%% %13.1f%% %13.1f%% %+12.1f\n",
+               nice_real[i], PESO_NICE[nice_real[i] + 20], teorica[i],
+               por_iter, por_cpu, por_iter - teorica[i]);
+    }
+    printf("\nCPU total dos filhos: %.2f s em %.2f s de parede (%.0f%% do core)\n",
+           soma_cpu / 1e9, (t_fim - t_ini) / 1e9, 100.0 * soma_cpu / (t_fim - t_ini));
+
+    munmap(cont, n * sizeof(Contador));
+    return 0;
+}
@@ -1,15 +1,47 @@
 // Preempção por fatia de tempo (time slice) – sem sleep, sem yield
-// Dois threads CPU-bound, cada um tentando monopolizar a CPU. Mesmo assim, 
+// Dois threads CPU-bound, cada um tentando monopolizar a CPU. Mesmo assim,
 // ambos “andam” porque o kernel preempteia (SCHED_OTHER).
-// 
+//
+// Modo "fatias": MEDE as fatias. Cada thread roda um laço apertado lendo o
+// relógio (CLOCK_MONOTONIC via vDSO, ~20 ns). Se entre duas leituras passou
+// mais que LIMIAR, a thread ficou fora da CPU: o intervalo é gravado num
+// buffer pré-alocado. Depois calculamos, por thread:
+//   - rodando:     quanto tempo ficou na CPU entre duas preempções (a fatia)
+//   - preemptada:  quanto tempo ficou esperando a outra thread
+// nos cenários SCHED_OTHER, SCHED_RR (comparado com sched_rr_get_interval)
+// e SCHED_OTHER com nice diferente. As duas threads ficam presas na CPU 0.
+//
+// Posicionamento (cpu_topo.h): em vez da CPU 0, as threads podem ser
+// colocadas por uma política de topologia. Em cores diferentes (espalhar,
+// sem_smt, dedicado) quase não há preempção: cada thread fica com ~100% de
+// um core; em irmãs SMT (compactar) não há preempção, mas as duas dividem
+// as unidades do mesmo core físico.
+//
+// Com "sched" (sched_stats.h) cada cenário termina com o que o KERNEL
+// contabilizou por thread: CPU, espera na runqueue e trocas de contexto,
+// para conferir as lacunas medidas em espaço de usuário.
+//
 // Para compilar e executar
-// gcc preempt_timeslice.c -o preempt_timeslice -lpthread
+// gcc -O2 preempt_timeslice.c -o preempt_timeslice -lpthread
 // ./preempt_timeslice
+// ./preempt_timeslice fatias              (os três cenários)
+// sudo ./preempt_timeslice fatias rr      (other | rr | nice)
+// ./preempt_timeslice fatias other espalhar   (livre | compactar | espalhar |
+//                                              sem_smt | dedicado)
+// ./preempt_timeslice fatias other sched      (+ estatísticas do kernel)
 
+#define _GNU_SOURCE     // pthread_setaffinity_np, gettid
 #include <stdio.h>      // printf
+#include <stdlib.h>     // malloc, qsort
+#include <string.h>     // strcmp, strerror
 #include <pthread.h>    // pthread_create, pthread_t
+#include <sched.h>      // SCHED_RR, sched_rr_get_interval, cpu_set_t
 #include <stdatomic.h>  // variáveis atômicas (seguras para concorrência)
+#include <sys/resource.h> // setpriority (nice por thread)
 #include <time.h>       // nanosleep
+#include <unistd.h>     // gettid
+#include "cpu_topo.h"   // topologia e políticas de afinidade
+#include "sched_stats.h" // schedstat / trocas de contexto por thread
 
 // Dois contadores globais, um para cada thread.
 // "atomic_ulong" garante que as operações são atômicas,
@@ -32,7 +64,242 @@ void* t2(void* _) {
     }
 }
 
-int main() {
+// ============================================================================
+// Modo "fatias": detector de lacunas (gaps) de execução
+// ============================================================================
+#define LIMIAR_NS     20000LL          // lacuna > 20 µs = thread saiu da CPU
+#define DURACAO_NS    2000000000LL     // 2 s por cenário
+#define MAX_LACUNAS   200000           // buffer pré-alocado por thread
+
+typedef struct {
+    long long ini, fim;                // instante em que parou / voltou a rodar
+} Lacuna;
+
+typedef struct {
+    int politica;                      // SCHED_OTHER ou SCHED_RR
+    int nice;                          // só para SCHED_OTHER
+    pthread_barrier_t *largada;
+    long long t_ini, t_fim;            // janela de medição
+    Lacuna *lacunas;                   // pré-alocado: nada de malloc no laço
+    int n;
+    int perdidas;                      // lacunas que não couberam no buffer
+    int cpu;                           // CPU fixada (-1 = livre)
+    const char *nome;
+    SsColetor *col;                    // != NULL: registra no coletor
+    struct timespec quantum;           // sched_rr_get_interval da própria thread
+} Medidor;
+
+static inline long long agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void* medir_lacunas(void* arg) {
+    Medidor *m = arg;
+    if (m->politica == SCHED_OTHER && m->nice != 0)
+        setpriority(PRIO_PROCESS, gettid(), m->nice);   // no Linux, nice é por thread
+    // O quantum depende da política de QUEM pergunta: consultamos aqui dentro.
+    sched_rr_get_interval(0, &m->quantum);
+    int slot = m->col ? ss_registrar(m->col, m->nome) : -1;
+
+    pthread_barrier_wait(m->largada);
+    long long ant = agora_ns();
+    m->t_ini = ant;
+    const long long fim = ant + DURACAO_NS;
+
+    // Laço apertado: só lê o relógio e compara. Qualquer salto grande entre
+    // duas leituras é tempo em que outra thread (ou IRQ longa) usou a CPU.
+    for (;;) {
+        long long t = agora_ns();
+        if (t - ant > LIMIAR_NS) {
+            if (m->n < MAX_LACUNAS)
+                m->lacunas[m->n++] = (Lacuna){ ant, t };
+            else
+                m->perdidas++;
+        }
+        ant = t;
+        if (t >= fim)
+            break;
+    }
+    m->t_fim = ant;
+    ss_sair(m->col, slot);
+    return NULL;
+}
+
+static int cmp_ll(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Imprime n, min, p50, p90, p99, máx (em ms) de um vetor de durações (ns).
+static void distribuicao(const char *rotulo, long long *v, int n) {
+    if (n == 0) {
+        printf("    %-11s %7d\n", rotulo, 0);
+        return;
+    }
+    qsort(v, n, sizeof(long long), cmp_ll);
+    printf("    %-11s %7d %9.3f %9.3f %9.3f %9.3f %9.3f\n", rotulo, n,
+           v[0] / 1e6, v[n / 2] / 1e6, v[(int)(n * 0.9)] / 1e6,
+           v[(int)(n * 0.99)] / 1e6, v[n - 1] / 1e6);
+}
+
+static void relatorio_thread(int id, Medidor *m) {
+    long long *rodando = malloc((m->n + 1) * sizeof(long long));
+    long long *parada  = malloc((m->n + 1) * sizeof(long long));
+    if (rodando == NULL || parada == NULL) { perror("malloc"); exit(1); }
+
+    // Trechos rodando = entre o fim de uma lacuna e o início da próxima.
+    // O primeiro e o último trecho são cortados pela janela: descartamos.
+    int nr = 0;
+    long long fora = 0;
+    for (int i = 0; i < m->n; i++) {
+        parada[i] = m->lacunas[i].fim - m->lacunas[i].ini;
+        fora += parada[i];
+        if (i > 0)
+            rodando[nr++] = m->lacunas[i].ini - m->lacunas[i - 1].fim;
+    }
+    double total = m->t_fim - m->t_ini;
+
+    char onde[16] = "livre";
+    if (m->cpu >= 0)
+        snprintf(onde, sizeof(onde), "cpu %d", m->cpu);
+    printf("  thread %d [%s]%s: CPU %.1f%% | %d preempções%s\n", id, onde,
+           m->politica == SCHED_OTHER && m->nice ? " (nice)" : "",
+           100.0 * (total - fora) / total, m->n,
+           m->perdidas ? " (buffer cheio: algumas perdidas)" : "");
+    distribuicao("rodando", rodando, nr);
+    distribuicao("preemptada", parada, m->n);
+    free(rodando);
+    free(parada);
+}
+
+// Posicionamento das threads: -1 = as duas na CPU 0 (padrão do experimento).
+static int posicionamento = -1;
+static Topologia topo;
+static int coletar_sched = 0;          // "sched": coletor de schedstat
+
+// Roda um cenário com duas threads (na CPU 0 ou conforme o posicionamento).
+// Retorna 0 se não deu para criar as threads com a política pedida (ex.: sem
+// permissão para RR).
+static int cenario(const char *titulo, int politica, int nice_t2) {
+    pthread_barrier_t largada;
+    pthread_barrier_init(&largada, NULL, 2);
+    Medidor m[2];
+    pthread_t th[2];
+    static const char *NOMES[2] = { "thread 1", "thread 2" };
+    static SsColetor col;
+    if (coletar_sched)
+        ss_iniciar(&col, 100);
+
+    for (int i = 0; i < 2; i++) {
+        m[i] = (Medidor){ .politica = politica, .nice = i == 1 ? nice_t2 : 0,
+                          .largada = &largada, .nome = NOMES[i],
+                          .col = coletar_sched ? &col : NULL };
+        m[i].lacunas = malloc(MAX_LACUNAS * sizeof(Lacuna));
+        if (m[i].lacunas == NULL) { perror("malloc"); exit(1); }
+
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        m[i].cpu = posicionamento < 0 ? 0 : topo_cpu_para(&topo, posicionamento, i);
+        if (posicionamento == TOPO_DEDICADO && m[i].cpu < 0)
+            fprintf(stderr, "  ⚠️  thread %d: sem core dedicado livre — fica sem afinidade\n", i + 1);
+        topo_fixar_attr(&attr, m[i].cpu);
+        if (politica == SCHED_RR) {
+            struct sched_param sp = { .sched_priority = 10 };
+            pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+            pthread_attr_setschedpolicy(&attr, SCHED_RR);
+            pthread_attr_setschedparam(&attr, &sp);
+        }
+        int rc = pthread_create(&th[i], &attr, medir_lacunas, &m[i]);
+        pthread_attr_destroy(&attr);
+        if (rc != 0) {
+            printf("\n%s\n  ⚠️  pthread_create: %s (SCHED_RR exige sudo/CAP_SYS_NICE) — pulando.\n",
+                   titulo, strerror(rc));
+            if (i == 1) {
+                // A primeira já está esperando na barreira: libera e descarta.
+                pthread_barrier_wait(&largada);
+                pthread_join(th[0], NULL);
+            }
+            for (int k = 0; k <= i; k++)
+                free(m[k].lacunas);
+            pthread_barrier_destroy(&largada);
+            if (coletar_sched)
+                ss_parar(&col);
+            return 0;
+        }
+    }
+    for (int i = 0; i < 2; i++)
+        pthread_join(th[i], NULL);
+
+    printf("\n%s\n", titulo);
+    printf("    %-11s %7s %9s %9s %9s %9s %9s\n", "(ms)", "n", "min", "p50", "p90", "p99", "máx");
+    for (int i = 0; i < 2; i++) {
+        relatorio_thread(i + 1, &m[i]);
+        free(m[i].lacunas);
+    }
+
+    if (politica == SCHED_RR)
+        printf("  quantum declarado (sched_rr_get_interval): %.3f ms\n",
+               m[0].quantum.tv_sec * 1e3 + m[0].quantum.tv_nsec / 1e6);
+    if (coletar_sched) {
+        ss_parar(&col);
+        ss_relatorio(&col);
+    }
+    pthread_barrier_destroy(&largada);
+    return 1;
+}
+
+static int modo_fatias(const char *qual, const char *onde) {
+    int todos = qual == NULL;
+    if (onde != NULL) {
+        posicionamento = topo_politica(onde);
+        if (posicionamento < 0 || topo_ler(&topo) != 0) {
+            fprintf(stderr, "posicionamento inválido: %s "
+                            "(use livre, compactar, espalhar, sem_smt ou dedicado)\n", onde);
+            return 1;
+        }
+        topo_imprimir(&topo);
+        printf("=== Fatias de tempo medidas (2 threads CPU-bound, posicionamento \"%s\", %.0f s cada) ===\n",
+               onde, DURACAO_NS / 1e9);
+    } else {
+        printf("=== Fatias de tempo medidas (2 threads CPU-bound na CPU 0, %.0f s cada) ===\n",
+               DURACAO_NS / 1e9);
+    }
+    printf("Lacuna > %lld µs entre leituras do relógio = thread fora da CPU\n", LIMIAR_NS / 1000);
+
+    int achou = 0;
+    if (todos || strcmp(qual, "other") == 0) {
+        cenario("SCHED_OTHER, nice 0 x nice 0", SCHED_OTHER, 0);
+        achou = 1;
+    }
+    if (todos || strcmp(qual, "rr") == 0) {
+        cenario("SCHED_RR prio 10 x prio 10", SCHED_RR, 0);
+        achou = 1;
+    }
+    if (todos || strcmp(qual, "nice") == 0) {
+        cenario("SCHED_OTHER, nice 0 x nice 5", SCHED_OTHER, 5);
+        achou = 1;
+    }
+    if (!achou) {
+        fprintf(stderr, "cenário desconhecido: %s (use other, rr ou nice)\n", qual);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "fatias") == 0) {
+        // Argumentos opcionais em qualquer ordem: cenário, posicionamento, "sched".
+        const char *qual = NULL, *onde = NULL;
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "sched") == 0)   coletar_sched = 1;
+            else if (topo_politica(argv[i]) >= 0) onde = argv[i];
+            else                                  qual = argv[i];
+        }
+        return modo_fatias(qual, onde);
+    }
+
     pthread_t a, b;
 
     // Criamos duas threads, ambas com a mesma prioridade e sem "sleep" ou "yield".
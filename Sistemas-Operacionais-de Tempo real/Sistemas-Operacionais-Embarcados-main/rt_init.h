@@ -0,0 +1,141 @@
+/*
+ * rt_init.h — modo tempo real SEM FALTAS DE PÁGINA
+ *
+ * Ideia:
+ *  - Uma falta de página no laço de controle custa de alguns µs (falta menor:
+ *    a página só precisa ser mapeada/zerada) a vários ms (falta maior: disco).
+ *    Para o laço nunca tomar faltas, TODA a memória que ele vai tocar precisa
+ *    estar mapeada e travada na RAM ANTES de ele começar:
+ *      1) mallopt: sem devolver heap ao kernel (M_TRIM_THRESHOLD = -1), sem
+ *         blocos grandes via mmap (M_MMAP_MAX = 0) e uma só arena para todas
+ *         as threads (M_ARENA_MAX = 1) — senão cada thread ganha um heap novo
+ *         que ninguém "pré-tocou";
+ *      2) mlockall(MCL_CURRENT | MCL_FUTURE): o que já existe e o que for
+ *         mapeado depois (pilhas de threads, crescimento do heap) fica na RAM;
+ *      3) pré-toque (prefault) de uma reserva de heap (malloc + escrever em
+ *         cada página + free: a memória volta para o malloc, não para o kernel)
+ *         e da pilha de cada thread RT.
+ *  - rt_mem_faltas() lê os contadores de faltas da PRÓPRIA thread
+ *    (getrusage RUSAGE_THREAD): a diferença entre o início e o fim do regime
+ *    permanente deve ser ZERO.
+ *  - rt_mem_relatorio() mostra o orçamento: memória travada (VmLck), residente
+ *    (VmRSS) e o limite RLIMIT_MEMLOCK.
+ *
+ * Uso típico:
+ *   #include "rt_init.h"
+ *   rt_mem_iniciar(8 << 20, 0);                   // main: 8 MB de reserva
+ *   pthread_attr_setstacksize(&attr, RT_PILHA);   // pilha travada é cara
+ *   ...
+ *   // na thread RT, antes do laço:
+ *   rt_mem_prefault_pilha(RT_PILHA_TOQUE);
+ *   long min0, maj0;  rt_mem_faltas(&min0, &maj0);
+ *
+ * Observação:
+ *   - mlockall exige CAP_IPC_LOCK (sudo) ou RLIMIT_MEMLOCK suficiente. Sem
+ *     isso rt_mem_iniciar() avisa, aplica o resto (mallopt + pré-toque) e
+ *     retorna 0: as páginas podem voltar a faltar se o sistema pressionar a
+ *     memória, mas em máquina folgada o efeito costuma aparecer.
+ *   - Com MCL_FUTURE cada pilha de thread (8 MB por padrão) é travada
+ *     inteira: use pilhas menores (RT_PILHA) nas threads criadas depois.
+ */
+
+#ifndef RT_INIT_H
+#define RT_INIT_H
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE           // RUSAGE_THREAD
+#endif
+#include <stdio.h>           // fprintf, fopen
+#include <stdlib.h>          // malloc, free
+#include <string.h>          // memset, strncmp, strerror
+#include <errno.h>           // errno
+#include <unistd.h>          // sysconf
+#include <malloc.h>          // mallopt
+#include <sys/mman.h>        // mlockall, munlockall
+#include <sys/resource.h>    // getrusage, getrlimit
+
+#define RT_PILHA        (256 * 1024)    // pilha das threads RT (travada inteira)
+#define RT_PILHA_TOQUE  (64 * 1024)     // quanto da pilha pré-tocar
+
+// Pré-toca 'bytes' da pilha da thread atual. noinline: o VLA precisa existir
+// de verdade abaixo do quadro de quem chamou.
+static __attribute__((noinline, unused)) void rt_mem_prefault_pilha(size_t bytes) {
+    volatile unsigned char pilha[bytes];
+    long pagina = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < bytes; i += (size_t)pagina)
+        pilha[i] = 0;
+    pilha[bytes - 1] = 0;
+    (void)pilha;
+}
+
+// Faltas de página (menores e maiores) da thread atual desde que ela nasceu.
+static inline void rt_mem_faltas(long *menores, long *maiores) {
+    struct rusage ru;
+    getrusage(RUSAGE_THREAD, &ru);
+    *menores = ru.ru_minflt;
+    *maiores = ru.ru_majflt;
+}
+
+// Configura o malloc, trava a memória e pré-toca heap e pilha da thread atual.
+// Retorna 1 se o mlockall funcionou, 0 se seguiu sem travar.
+static inline int rt_mem_iniciar(size_t heap_bytes, size_t pilha_bytes) {
+    mallopt(M_TRIM_THRESHOLD, -1);      // free() nunca devolve o topo do heap
+    mallopt(M_MMAP_MAX, 0);             // nada de mmap/munmap por bloco grande
+    mallopt(M_ARENA_MAX, 1);            // todas as threads usam o heap pré-tocado
+
+    int travou = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+    if (!travou)
+        fprintf(stderr, "⚠️  mlockall: %s (use sudo ou aumente ulimit -l): "
+                        "memória NÃO travada, só pré-tocada.\n", strerror(errno));
+
+    if (heap_bytes > 0) {
+        unsigned char *reserva = malloc(heap_bytes);
+        if (reserva == NULL) {
+            fprintf(stderr, "⚠️  reserva de heap de %zu bytes falhou\n", heap_bytes);
+        } else {
+            long pagina = sysconf(_SC_PAGESIZE);
+            for (size_t i = 0; i < heap_bytes; i += (size_t)pagina)
+                reserva[i] = 1;
+            free(reserva);              // volta para o malloc (trim desligado)
+        }
+    }
+    if (pilha_bytes > 0)
+        rt_mem_prefault_pilha(pilha_bytes);
+    return travou;
+}
+
+// Desfaz o que dá para desfazer (o malloc fica como está).
+static inline void rt_mem_encerrar(void) {
+    munlockall();
+}
+
+// Lê um campo "Nome:   valor kB" de /proc/self/status (-1 se não existir).
+static inline long rt_mem_status_kb(const char *campo) {
+    FILE *f = fopen("/proc/self/status", "r");
+    if (f == NULL)
+        return -1;
+    char linha[256];
+    long kb = -1;
+    size_t n = strlen(campo);
+    while (fgets(linha, sizeof(linha), f))
+        if (strncmp(linha, campo, n) == 0 && linha[n] == ':') {
+            kb = atol(linha + n + 1);
+            break;
+        }
+    fclose(f);
+    return kb;
+}
+
+// Orçamento de memória do processo.
+static inline void rt_mem_relatorio(FILE *saida) {
+    struct rlimit lim;
+    getrlimit(RLIMIT_MEMLOCK, &lim);
+    fprintf(saida, "Memória: travada (VmLck) %ld kB | residente (VmRSS) %ld kB | pico (VmHWM) %ld kB | ",
+            rt_mem_status_kb("VmLck"), rt_mem_status_kb("VmRSS"), rt_mem_status_kb("VmHWM"));
+    if (lim.rlim_cur == RLIM_INFINITY)
+        fprintf(saida, "RLIMIT_MEMLOCK ilimitado\n");
+    else
+        fprintf(saida, "RLIMIT_MEMLOCK %llu kB\n", (unsigned long long)lim.rlim_cur / 1024);
+}
+
+#endif
@@ -0,0 +1,513 @@
+/*
+ * Medição de LATÊNCIA DE DESPERTAR (estilo cyclictest)
+ *
+ * Ideia:
+ *  - N threads periódicas. Cada uma calcula o próximo instante de ativação
+ *    (relógio ABSOLUTO em CLOCK_MONOTONIC) e dorme com
+ *    clock_nanosleep(TIMER_ABSTIME). Ao acordar, lê o relógio de novo:
+ *        latência = instante em que voltou a rodar - instante pedido
+ *  - Esse atraso soma: precisão do timer, tempo para o escalonador colocar a
+ *    thread na CPU (preempção desligada, IRQs, outras tarefas RT...) e a troca
+ *    de contexto. É o número que importa para um laço de controle.
+ *  - Cada thread grava no SEU histograma (1 µs por balde), sem lock: só ela
+ *    escreve; a main apenas lê (atômicos relaxados) para mostrar o andamento.
+ *  - Também guardamos as PIORES amostras de cada thread com o instante em que
+ *    ocorreram, para correlacionar com logs / outras cargas da máquina.
+ *  - Modo de memória (-M, rt_init.h): com "on" a memória é travada
+ *    (mlockall), heap e pilhas são pré-tocados e o malloc não devolve memória
+ *    ao kernel; cada thread conta as faltas de página tomadas DENTRO do laço
+ *    (getrusage RUSAGE_THREAD), que devem ser zero. "ambos" roda a mesma
+ *    medição com o modo desligado e ligado (um processo novo para cada) e
+ *    compara. Com -b cada ciclo também faz um trabalho que aloca, escreve e
+ *    libera um buffer — o padrão comum que, sem o modo RT, vira mmap/munmap
+ *    e faltas de página a cada ciclo.
+ *
+ * Como compilar:
+ *   gcc -O2 -pthread rt_latency.c -o rt_latency
+ *
+ * Como executar:
+ *   ./rt_latency                          (1 thread, SCHED_OTHER, 1 ms, 10 s)
+ *   sudo ./rt_latency -p fifo -P 80 -t 4 -i 500 -D 60
+ *   sudo ./rt_latency -p fifo -a -H      (uma thread por CPU + histograma)
+ *   sudo ./rt_latency -p fifo -M ambos -b 256 -D 5   (faltas de página: off x on)
+ *
+ * Opções:
+ *   -t N     número de threads (padrão 1)
+ *   -i US    período em microssegundos (padrão 1000); a thread k usa i + k*d
+ *   -d US    incremento do período entre threads (padrão 0)
+ *   -p POL   other | fifo | rr (padrão other)
+ *   -P PRIO  prioridade RT da thread 0; as demais usam PRIO-1, PRIO-2... (80)
+ *   -D S     duração em segundos (padrão 10; Ctrl+C encerra antes)
+ *   -a       prende a thread k na CPU k % nproc
+ *   -m US    limite do histograma em µs (padrão 1000); acima disso = estouro
+ *   -w K     quantas piores amostras guardar por thread (padrão 8)
+ *   -H       imprime o histograma completo (baldes não vazios)
+ *   -M MODO  memória: off | on | ambos (padrão off; veja rt_init.h)
+ *   -b KB    trabalho por ciclo: aloca, escreve e libera KB de heap (padrão 0)
+ *
+ * Observação:
+ *   - SCHED_FIFO/RR exigem sudo (ou CAP_SYS_NICE). Sem permissão o programa
+ *     avisa e mede em SCHED_OTHER.
+ *   - Para qualificar uma máquina, rode junto com a carga real (ou um
+ *     stress) por minutos/horas: o MÁXIMO é o que interessa, não a média.
+ */
+
+#define _GNU_SOURCE           // pthread_setaffinity_np, CPU_SET, gettid
+#include "rt_init.h"         // mlockall, pré-toque, contagem de faltas
+#include <stdio.h>           // printf, fprintf
+#include <stdlib.h>          // atoi, calloc, exit
+#include <stdint.h>          // uint64_t
+#include <stdatomic.h>       // contadores lidos pela main sem lock
+#include <string.h>          // strcmp, strerror
+#include <errno.h>           // EINTR
+#include <unistd.h>          // getopt, sysconf
+#include <pthread.h>         // pthread_create, pthread_setschedparam
+#include <sched.h>           // SCHED_FIFO, cpu_set_t
+#include <signal.h>          // sigaction (Ctrl+C)
+#include <time.h>            // clock_nanosleep, clock_gettime
+#include <sys/wait.h>        // waitpid (-M ambos)
+
+#define NS_POR_S  1000000000LL
+
+// ----------------------------------------------------------------------------
+// Configuração (linha de comando)
+// ----------------------------------------------------------------------------
+static int  n_threads   = 1;
+static long periodo_us  = 1000;
+static long delta_us    = 0;
+static int  politica    = SCHED_OTHER;
+static int  prioridade  = 80;
+static int  duracao_s   = 10;
+static int  fixar_cpu   = 0;
+static int  hist_max_us = 1000;
+static int  n_piores    = 8;
+static int  mostrar_hist = 0;
+static long buffer_kb   = 0;
+
+enum { MEM_OFF, MEM_ON, MEM_AMBOS };
+static int  modo_mem    = MEM_OFF;
+static int  mem_ativa   = 0;          // modo RT de memória ligado neste processo
+
+static atomic_int parar = 0;          // Ctrl+C ou fim da duração
+static long long t_inicio;            // base dos instantes impressos
+
+// ----------------------------------------------------------------------------
+// Estatística por thread (um único escritor: a própria thread)
+// ----------------------------------------------------------------------------
+typedef struct {
+    long long lat_ns;                 // atraso da amostra
+    long long quando_ns;              // instante (desde o início do teste)
+    uint64_t  ciclo;                  // número do ciclo
+} Amostra;
+
+typedef struct {
+    int id;
+    pid_t tid;
+    int cpu;                          // CPU fixada (-1 = livre)
+    int prio;
+    long periodo_us;
+    // Lidos pela main durante a execução → atômicos (store/load relaxados,
+    // sem RMW: com um só escritor isso basta e não custa nada no x86/ARM).
+    _Alignas(64) atomic_ullong ciclos;
+    atomic_llong min_ns, max_ns, ult_ns;
+    atomic_ullong soma_ns;
+    atomic_ullong estouros;           // amostras acima de hist_max_us
+    atomic_ullong perdidos;           // períodos inteiros pulados
+    atomic_ullong *hist;              // hist[us] = contagem, 0..hist_max_us-1
+    Amostra *piores;                  // ordenado do maior para o menor
+    int n_guardadas;
+    // Escritos pela thread só no fim (a main lê depois do join).
+    long faltas_min, faltas_maj;      // faltas de página dentro do laço
+    long long trab_max_ns, trab_soma_ns;   // tempo do trabalho de -b
+} Estat;
+
+static Estat *estat;
+
+static inline long long agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * NS_POR_S + ts.tv_nsec;
+}
+
+static inline struct timespec ns_para_ts(long long ns) {
+    struct timespec ts = { .tv_sec = ns / NS_POR_S, .tv_nsec = ns % NS_POR_S };
+    return ts;
+}
+
+// Incremento com um único escritor: load + store, sem instrução atômica cara.
+#define INC_RELAXADO(var, v) \
+    atomic_store_explicit(&(var), atomic_load_explicit(&(var), memory_order_relaxed) + (v), \
+                          memory_order_relaxed)
+
+// Insere na lista das piores amostras (ordem decrescente, tamanho n_piores).
+static void guardar_pior(Estat *e, long long lat, long long quando, uint64_t ciclo) {
+    if (n_piores == 0)
+        return;
+    if (e->n_guardadas == n_piores && lat <= e->piores[n_piores - 1].lat_ns)
+        return;                                       // caminho comum: nada a fazer
+    int i = e->n_guardadas < n_piores ? e->n_guardadas++ : n_piores - 1;
+    while (i > 0 && e->piores[i - 1].lat_ns < lat) {
+        e->piores[i] = e->piores[i - 1];
+        i--;
+    }
+    e->piores[i] = (Amostra){ lat, quando, ciclo };
+}
+
+static void registrar(Estat *e, long long lat, long long quando, uint64_t ciclo) {
+    long long us = lat / 1000;
+    if (us < hist_max_us)
+        INC_RELAXADO(e->hist[us], 1);
+    else
+        INC_RELAXADO(e->estouros, 1);
+
+    if (lat < atomic_load_explicit(&e->min_ns, memory_order_relaxed))
+        atomic_store_explicit(&e->min_ns, lat, memory_order_relaxed);
+    if (lat > atomic_load_explicit(&e->max_ns, memory_order_relaxed))
+        atomic_store_explicit(&e->max_ns, lat, memory_order_relaxed);
+    atomic_store_explicit(&e->ult_ns, lat, memory_order_relaxed);
+    INC_RELAXADO(e->soma_ns, (unsigned long long)lat);
+    guardar_pior(e, lat, quando, ciclo);
+    // Por último: quem lê 'ciclos' vê as outras estatísticas quase em dia.
+    atomic_store_explicit(&e->ciclos, ciclo + 1, memory_order_release);
+}
+
+// ----------------------------------------------------------------------------
+// Thread de medição
+// ----------------------------------------------------------------------------
+static void* medidor(void* arg) {
+    Estat *e = arg;
+    e->tid = gettid();
+
+    if (e->cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(e->cpu, &cpus);
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (rc != 0)
+            fprintf(stderr, "T%d: afinidade CPU %d falhou: %s\n", e->id, e->cpu, strerror(rc));
+    }
+
+    if (mem_ativa)
+        rt_mem_prefault_pilha(RT_PILHA_TOQUE);
+
+    const long long periodo = e->periodo_us * 1000LL;
+    const size_t buffer = (size_t)buffer_kb * 1024;
+    long long proximo = agora_ns() + periodo;
+    uint64_t ciclo = 0;
+    long min0, maj0;
+    rt_mem_faltas(&min0, &maj0);
+
+    while (!atomic_load_explicit(&parar, memory_order_relaxed)) {
+        struct timespec ts = ns_para_ts(proximo);
+        int rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        if (rc == EINTR)
+            continue;
+        if (rc != 0) {
+            fprintf(stderr, "T%d: clock_nanosleep: %s\n", e->id, strerror(rc));
+            break;
+        }
+        long long acordou = agora_ns();
+        long long lat = acordou - proximo;
+        registrar(e, lat, acordou - t_inicio, ciclo++);
+
+        if (buffer > 0) {
+            // "Trabalho" típico de um ciclo: buffer temporário no heap.
+            unsigned char *b = malloc(buffer);
+            if (b != NULL) {
+                for (size_t i = 0; i < buffer; i += 4096)
+                    b[i] = (unsigned char)ciclo;
+                free(b);
+            }
+            long long dt = agora_ns() - acordou;
+            e->trab_soma_ns += dt;
+            if (dt > e->trab_max_ns)
+                e->trab_max_ns = dt;
+        }
+
+        proximo += periodo;
+        if (acordou > proximo) {
+            // Atrasou mais de um período: não "recupera" disparando em rajada
+            // (isso mascararia as próximas latências). Realinha e conta.
+            long long pulos = (acordou - proximo) / periodo + 1;
+            INC_RELAXADO(e->perdidos, (unsigned long long)pulos);
+            proximo += pulos * periodo;
+        }
+    }
+    long min1, maj1;
+    rt_mem_faltas(&min1, &maj1);
+    e->faltas_min = min1 - min0;
+    e->faltas_maj = maj1 - maj0;
+    return NULL;
+}
+
+// ----------------------------------------------------------------------------
+// Relatório
+// ----------------------------------------------------------------------------
+// Percentil a partir do histograma (resolução de 1 µs). Retorna -1 se cair
+// na faixa de estouro (acima de hist_max_us).
+static long percentil_us(Estat *e, uint64_t total, double p) {
+    uint64_t alvo = (uint64_t)(p * total + 0.999999), acum = 0;
+    if (alvo == 0)
+        alvo = 1;
+    for (int us = 0; us < hist_max_us; us++) {
+        acum += atomic_load_explicit(&e->hist[us], memory_order_relaxed);
+        if (acum >= alvo)
+            return us;
+    }
+    return -1;
+}
+
+static void linha_andamento(void) {
+    for (int i = 0; i < n_threads; i++) {
+        Estat *e = &estat[i];
+        uint64_t c = atomic_load_explicit(&e->ciclos, memory_order_acquire);
+        if (c == 0) {
+            printf("T:%2d (%6d) P:%2d I:%ld C:%9d\n", i, e->tid, e->prio, e->periodo_us, 0);
+            continue;
+        }
+        printf("T:%2d (%6d) P:%2d I:%ld C:%9llu Min:%7lld Act:%7lld Avg:%7llu Max:%7lld\n",
+               i, e->tid, e->prio, e->periodo_us, (unsigned long long)c,
+               atomic_load_explicit(&e->min_ns, memory_order_relaxed) / 1000,
+               atomic_load_explicit(&e->ult_ns, memory_order_relaxed) / 1000,
+               atomic_load_explicit(&e->soma_ns, memory_order_relaxed) / c / 1000,
+               atomic_load_explicit(&e->max_ns, memory_order_relaxed) / 1000);
+    }
+}
+
+static void relatorio_final(void) {
+    printf("\n=== Resumo (µs) ===\n");
+    printf("%-4s %4s %5s %7s %10s %7s %7s %7s %7s %8s %8s %13s\n",
+           "thr", "cpu", "prio", "per", "amostras", "min", "média", "p99", "max",
+           "estouros", "perdidos", "faltas mín/maj");
+    for (int i = 0; i < n_threads; i++) {
+        Estat *e = &estat[i];
+        uint64_t c = atomic_load(&e->ciclos);
+        if (c == 0) {
+            printf("T%-3d sem amostras\n", i);
+            continue;
+        }
+        long p99 = percentil_us(e, c, 0.99);
+        char p99s[16];
+        if (p99 < 0) snprintf(p99s, sizeof(p99s), ">%d", hist_max_us);
+        else         snprintf(p99s, sizeof(p99s), "%ld", p99);
+        printf("T%-3d %4d %5d %7ld %10llu %7.1f %7.1f %7s %7.1f %8llu %8llu %8ld/%ld\n",
+               i, e->cpu, e->prio, e->periodo_us, (unsigned long long)c,
+               atomic_load(&e->min_ns) / 1e3, (double)atomic_load(&e->soma_ns) / c / 1e3,
+               p99s, atomic_load(&e->max_ns) / 1e3,
+               (unsigned long long)atomic_load(&e->estouros),
+               (unsigned long long)atomic_load(&e->perdidos), e->faltas_min, e->faltas_maj);
+    }
+    if (buffer_kb > 0) {
+        printf("\nTrabalho por ciclo (malloc + escrita + free de %ld KB), µs:\n", buffer_kb);
+        for (int i = 0; i < n_threads; i++) {
+            Estat *e = &estat[i];
+            uint64_t c = atomic_load(&e->ciclos);
+            if (c > 0)
+                printf("T%-3d média %7.1f   máx %7.1f\n", i,
+                       e->trab_soma_ns / 1e3 / c, e->trab_max_ns / 1e3);
+        }
+    }
+
+    if (n_piores > 0) {
+        printf("\n=== Piores amostras (instante desde o início) ===\n");
+        for (int i = 0; i < n_threads; i++) {
+            Estat *e = &estat[i];
+            printf("T%d:", i);
+            for (int k = 0; k < e->n_guardadas; k++) {
+                Amostra *a = &e->piores[k];
+                if (k > 0)
+                    printf(k % 3 == 0 ? ",\n   " : ",");
+                printf(" %.1f µs @ %.3f s (ciclo %llu)",
+                       a->lat_ns / 1e3, a->quando_ns / 1e9, (unsigned long long)a->ciclo);
+            }
+            printf("\n");
+        }
+    }
+
+    if (mostrar_hist) {
+        printf("\n=== Histograma (µs: contagem por thread) ===\n");
+        for (int us = 0; us < hist_max_us; us++) {
+            int vazio = 1;
+            for (int i = 0; i < n_threads && vazio; i++)
+                vazio = atomic_load(&estat[i].hist[us]) == 0;
+            if (vazio)
+                continue;
+            printf("%6d", us);
+            for (int i = 0; i < n_threads; i++)
+                printf(" %10llu", (unsigned long long)atomic_load(&estat[i].hist[us]));
+            printf("\n");
+        }
+        printf("%6s", "estour");
+        for (int i = 0; i < n_threads; i++)
+            printf(" %10llu", (unsigned long long)atomic_load(&estat[i].estouros));
+        printf("\n");
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Programa principal
+// ----------------------------------------------------------------------------
+static void ao_sinal(int sig) {
+    (void)sig;
+    atomic_store(&parar, 1);
+}
+
+static int medir(int travar_memoria);
+
+static void uso(const char *prog) {
+    fprintf(stderr,
+            "uso: %s [-t threads] [-i período_us] [-d delta_us] [-p other|fifo|rr]\n"
+            "          [-P prio] [-D segundos] [-a] [-m hist_max_us] [-w piores] [-H]\n"
+            "          [-M off|on|ambos] [-b KB]\n",
+            prog);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    int op;
+    while ((op = getopt(argc, argv, "t:i:d:p:P:D:am:w:HM:b:")) != -1) {
+        switch (op) {
+        case 't': n_threads   = atoi(optarg); break;
+        case 'i': periodo_us  = atol(optarg); break;
+        case 'd': delta_us    = atol(optarg); break;
+        case 'P': prioridade  = atoi(optarg); break;
+        case 'D': duracao_s   = atoi(optarg); break;
+        case 'a': fixar_cpu   = 1;            break;
+        case 'm': hist_max_us = atoi(optarg); break;
+        case 'w': n_piores    = atoi(optarg); break;
+        case 'H': mostrar_hist = 1;           break;
+        case 'b': buffer_kb   = atol(optarg); break;
+        case 'M':
+            if      (strcmp(optarg, "off")   == 0) modo_mem = MEM_OFF;
+            else if (strcmp(optarg, "on")    == 0) modo_mem = MEM_ON;
+            else if (strcmp(optarg, "ambos") == 0) modo_mem = MEM_AMBOS;
+            else uso(argv[0]);
+            break;
+        case 'p':
+            if      (strcmp(optarg, "other") == 0) politica = SCHED_OTHER;
+            else if (strcmp(optarg, "fifo")  == 0) politica = SCHED_FIFO;
+            else if (strcmp(optarg, "rr")    == 0) politica = SCHED_RR;
+            else uso(argv[0]);
+            break;
+        default: uso(argv[0]);
+        }
+    }
+    if (n_threads < 1 || periodo_us < 1 || delta_us < 0 || hist_max_us < 1 ||
+        n_piores < 0 || duracao_s < 1 || buffer_kb < 0)
+        uso(argv[0]);
+
+    struct sigaction sa = { .sa_handler = ao_sinal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    if (modo_mem != MEM_AMBOS)
+        return medir(modo_mem == MEM_ON);
+
+    // "ambos": cada fase num processo novo, para o modo desligado não herdar
+    // nada (heap, travas) do ligado.
+    for (int fase = 0; fase < 2; fase++) {
+        printf("\n########## Memória RT %s ##########\n", fase ? "LIGADA" : "DESLIGADA");
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid < 0) { perror("fork"); return 1; }
+        if (pid == 0)
+            exit(medir(fase));
+        int st;
+        waitpid(pid, &st, 0);
+        if (atomic_load(&parar))
+            break;
+    }
+    return 0;
+}
+
+// Uma medição completa (threads, andamento e relatório) neste processo.
+static int medir(int travar_memoria) {
+    if (travar_memoria) {
+        // 4 MB de reserva por thread + o buffer de trabalho; o pré-toque da
+        // pilha de cada thread é feito por ela mesma.
+        size_t reserva = (size_t)n_threads * (4u << 20) + (size_t)buffer_kb * 2048;
+        int travou = rt_mem_iniciar(reserva, RT_PILHA_TOQUE);
+        mem_ativa = 1;
+        printf("Memória RT: %s, reserva de heap de %zu KB pré-tocada\n",
+               travou ? "mlockall OK" : "SEM mlockall", reserva / 1024);
+    }
+
+    int ncpu = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    estat = calloc(n_threads, sizeof(Estat));
+    if (estat == NULL) { perror("calloc"); return 1; }
+    for (int i = 0; i < n_threads; i++) {
+        Estat *e = &estat[i];
+        e->id = i;
+        e->cpu = fixar_cpu ? i % ncpu : -1;
+        e->periodo_us = periodo_us + i * delta_us;
+        e->prio = politica == SCHED_OTHER ? 0 : (prioridade - i > 1 ? prioridade - i : 1);
+        atomic_init(&e->min_ns, INT64_MAX);
+        e->hist = calloc(hist_max_us, sizeof(atomic_ullong));
+        e->piores = calloc(n_piores ? n_piores : 1, sizeof(Amostra));
+        if (e->hist == NULL || e->piores == NULL) { perror("calloc"); return 1; }
+    }
+
+    // Política RT: criamos as threads já com a política/prioridade certas
+    // (PTHREAD_EXPLICIT_SCHED). Se não houver permissão, avisamos e medimos
+    // em SCHED_OTHER — o número continua útil como referência.
+    const char *nomes[] = { [SCHED_OTHER] = "SCHED_OTHER", [SCHED_FIFO] = "SCHED_FIFO",
+                            [SCHED_RR] = "SCHED_RR" };
+    pthread_t *th = calloc((size_t)n_threads, sizeof(pthread_t));
+    if (th == NULL) { perror("calloc"); return 1; }
+    t_inicio = agora_ns();
+    for (int i = 0; i < n_threads; i++) {
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if (mem_ativa)
+            pthread_attr_setstacksize(&attr, RT_PILHA);   // pilha inteira fica travada
+        if (politica != SCHED_OTHER) {
+            struct sched_param sp = { .sched_priority = estat[i].prio };
+            pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+            pthread_attr_setschedpolicy(&attr, politica);
+            pthread_attr_setschedparam(&attr, &sp);
+        }
+        int rc = pthread_create(&th[i], &attr, medidor, &estat[i]);
+        if (rc == EPERM && politica != SCHED_OTHER) {
+            fprintf(stderr, "⚠️  Sem permissão para %s (use sudo ou CAP_SYS_NICE): "
+                            "medindo em SCHED_OTHER.\n", nomes[politica]);
+            politica = SCHED_OTHER;
+            for (int k = 0; k < n_threads; k++)
+                estat[k].prio = 0;
+            pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+            rc = pthread_create(&th[i], &attr, medidor, &estat[i]);
+        }
+        pthread_attr_destroy(&attr);
+        if (rc != 0) {
+            fprintf(stderr, "pthread_create: %s\n", strerror(rc));
+            return 1;
+        }
+    }
+
+    printf("=== Latência de despertar (clock_nanosleep ABSTIME, CLOCK_MONOTONIC) ===\n");
+    printf("Threads: %d | Política: %s | Período: %ld µs (+%ld por thread) | Duração: %d s\n\n",
+           n_threads, nomes[politica], periodo_us, delta_us, duracao_s);
+
+    // A main só acompanha: a cada segundo mostra o andamento (valores em µs).
+    for (int s = 0; s < duracao_s && !atomic_load(&parar); s++) {
+        struct timespec um_s = { 1, 0 };
+        nanosleep(&um_s, NULL);
+        linha_andamento();
+        if (isatty(STDOUT_FILENO) && s + 1 < duracao_s && !atomic_load(&parar))
+            printf("\033[%dA", n_threads);            // volta o cursor (atualiza no lugar)
+    }
+    atomic_store(&parar, 1);
+    for (int i = 0; i < n_threads; i++)
+        pthread_join(th[i], NULL);
+
+    relatorio_final();
+    if (mem_ativa || modo_mem == MEM_AMBOS)
+        rt_mem_relatorio(stdout);
+
+    for (int i = 0; i < n_threads; i++) {
+        free(estat[i].hist);
+        free(estat[i].piores);
+    }
+    free(estat);
+    free(th);
+    return 0;
+}
@@ -0,0 +1,504 @@
+/*
+ * ===========================================
+ * EXECUTIVO DE TAREFAS PERIÓDICAS (RM / EDF) EM ESPAÇO DE USUÁRIO
+ * ===========================================
+ * Objetivo:
+ *   Rodar tarefas periódicas no Linux com garantias MEDIDAS. Cada tarefa
+ *   declara período (T), orçamento de execução (C, o WCET) e deadline
+ *   relativo (D, padrão = T). O executivo libera os jobs nos instantes
+ *   nominais (t0 + k*T) e registra, para cada job: liberação, início, fim
+ *   e CPU usada.
+ *
+ * Dois modos de escalonamento (todas as threads na mesma CPU, como na
+ * teoria de escalonamento monoprocessador):
+ *   - RT_RM  (Rate Monotonic): uma thread SCHED_FIFO por tarefa, prioridade
+ *            fixa pelo período (menor T → maior prioridade). Cada thread se
+ *            libera sozinha com clock_nanosleep(TIMER_ABSTIME).
+ *   - RT_FP  (prioridade fixa dada): como RT_RM, mas usa t->prio (1..99)
+ *            preenchido pelo usuário (ex.: Deadline Monotonic ou uma
+ *            atribuição vinda de outra ferramenta).
+ *   - RT_EDF (Earliest Deadline First): um DESPACHANTE em prioridade maior
+ *            libera os jobs e, a cada liberação/término, reordena as tarefas
+ *            ativas pelo deadline absoluto e troca as prioridades SCHED_FIFO
+ *            (deadline mais próximo → maior prioridade).
+ *
+ * Contabilidade por tarefa:
+ *   - tempo de resposta (fim - liberação): mín/médio/máx;
+ *   - jitter de início (início - liberação) e de resposta (máx - mín);
+ *   - perdas de deadline (fim > liberação + D);
+ *   - ESTOUROS de orçamento: um timer POSIX sobre CLOCK_THREAD_CPUTIME_ID
+ *     dispara (SIGRTMIN, direcionado à própria thread) quando o job consome
+ *     mais CPU que C. O job não é abortado: o estouro é contado e registrado.
+ *
+ * Jobs atrasados NÃO são descartados: se um job termina depois da próxima
+ * liberação, o seguinte começa imediatamente (e o atraso aparece na resposta).
+ *
+ * Sem privilégio para SCHED_FIFO (sudo/CAP_SYS_NICE) o executivo avisa e
+ * roda em SCHED_OTHER: as medições continuam válidas, as garantias não.
+ *
+ * Uso:
+ *   RtTarefa t[] = { { .nome = "ctrl", .periodo_us = 10000, .wcet_us = 2000,
+ *                      .corpo = minha_funcao, .arg = NULL }, ... };
+ *   rt_executar(t, n, RT_RM, 5000, 0);      // 5 s na CPU 0
+ *   rt_relatorio(t, n);
+ *   rt_liberar(t, n);
+ *
+ * Compilar junto com: -pthread -lrt
+ */
+
+#ifndef RT_PERIODIC_H
+#define RT_PERIODIC_H
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE           // gettid, CPU_SET, sigev_notify_thread_id
+#endif
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// glibc < 2.36 não exporta o nome "oficial" do campo usado por SIGEV_THREAD_ID.
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+#define RT_PRIO_DESPACHANTE 90        // EDF: despachante acima de todas as tarefas
+#define RT_PRIO_TOPO        80        // prioridade da tarefa mais urgente
+
+typedef enum { RT_RM, RT_FP, RT_EDF } RtModo;
+
+// Um job registrado (instantes em ns desde t0)
+typedef struct {
+    long long liberacao, inicio, fim;
+    long long cpu_ns;                  // CPU consumida pelo job
+    int estourou;                      // passou do orçamento (wcet_us)
+} RtJob;
+
+struct RtExec;
+
+typedef struct RtTarefa {
+    // ---- declarado pelo usuário ----
+    const char *nome;
+    long periodo_us;                   // T
+    long wcet_us;                      // C (orçamento)
+    long deadline_us;                  // D (0 → igual ao período)
+    void (*corpo)(struct RtTarefa *t, void *arg);
+    void *arg;
+
+    // ---- preenchido pelo executivo ----
+    int prio;                          // RM/FP: fixa; EDF: a atual
+    long long jobs, perdas, estouros;
+    long long resp_min, resp_max, resp_soma;       // tempo de resposta (ns)
+    long long ini_min, ini_max;                    // início - liberação (ns)
+    long long exec_max;                            // maior CPU por job (ns)
+    RtJob *log;                                    // um registro por job
+    long long log_cap;
+
+    // ---- estado interno ----
+    pthread_t th;
+    timer_t timer_cpu;
+    int tem_timer;
+    struct RtExec *exec;
+    long long liberados, concluidos;   // EDF (protegidos por exec->mtx)
+    sem_t sem_job;                     // EDF: despachante → tarefa
+} RtTarefa;
+
+typedef struct RtExec {
+    RtModo modo;
+    RtTarefa *t;
+    int n;
+    int cpu;                           // CPU de todas as threads (-1 = livre)
+    int rt;                            // 1 = SCHED_FIFO disponível
+    long long t0;                      // base de tempo (CLOCK_MONOTONIC, ns)
+    atomic_int parar;
+    pthread_mutex_t mtx;               // EDF: estado dos jobs
+    pthread_cond_t cond;               // EDF: acorda o despachante
+} RtExec;
+
+/* ----------------------------------------------------------
+ * Utilitários de tempo
+ * ---------------------------------------------------------- */
+static inline long long rt_agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline long long rt_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline struct timespec rt_ts(long long ns) {
+    struct timespec ts = { .tv_sec = ns / 1000000000LL, .tv_nsec = ns % 1000000000LL };
+    return ts;
+}
+
+static inline void rt_dormir_ate(long long abs_ns) {
+    struct timespec ts = rt_ts(abs_ns);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+}
+
+// Carga sintética: gira até a THREAD consumir 'us' de CPU (preempção não conta).
+static inline void rt_girar_cpu_us(long us) {
+    long long fim = rt_cpu_ns() + us * 1000LL;
+    while (rt_cpu_ns() < fim)
+        ;
+}
+
+static inline long rt_deadline_us(const RtTarefa *t) {
+    return t->deadline_us > 0 ? t->deadline_us : t->periodo_us;
+}
+
+/* ----------------------------------------------------------
+ * Detecção de estouro: timer de CPU por thread
+ * ---------------------------------------------------------- */
+static _Thread_local volatile sig_atomic_t rt_estourou;
+
+static void rt_ao_estouro(int sig) {
+    (void)sig;
+    rt_estourou = 1;                   // só marca: o job segue até o fim
+}
+
+// Cria o timer sobre o relógio de CPU da thread chamadora; o sinal vai para
+// ELA (SIGEV_THREAD_ID), não para uma thread qualquer do processo.
+static inline void rt_criar_timer_cpu(RtTarefa *t) {
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_THREAD_ID;
+    sev.sigev_signo = SIGRTMIN;
+    sev.sigev_notify_thread_id = gettid();
+    if (timer_create(CLOCK_THREAD_CPUTIME_ID, &sev, &t->timer_cpu) == 0)
+        t->tem_timer = 1;
+    else
+        fprintf(stderr, "%s: timer_create: %s (sem detecção de estouro)\n",
+                t->nome, strerror(errno));
+}
+
+static inline void rt_armar_timer_cpu(RtTarefa *t, long us) {
+    if (!t->tem_timer)
+        return;
+    // Relativo ao consumo ATUAL de CPU da thread: dispara após 'us' de CPU.
+    struct itimerspec its = { .it_value = rt_ts(us * 1000LL) };
+    timer_settime(t->timer_cpu, 0, &its, NULL);
+}
+
+/* ----------------------------------------------------------
+ * Execução e registro de um job
+ * ---------------------------------------------------------- */
+static void rt_rodar_job(RtTarefa *t, long long liberacao) {
+    RtExec *ex = t->exec;
+    long long inicio = rt_agora_ns();
+    long long cpu0 = rt_cpu_ns();
+
+    rt_estourou = 0;
+    rt_armar_timer_cpu(t, t->wcet_us);
+    t->corpo(t, t->arg);
+    rt_armar_timer_cpu(t, 0);          // desarma
+    if (!t->tem_timer && rt_cpu_ns() - cpu0 > t->wcet_us * 1000LL)
+        rt_estourou = 1;               // sem timer: confere no fim
+
+    long long fim = rt_agora_ns();
+    long long cpu = rt_cpu_ns() - cpu0;
+
+    long long resp = fim - liberacao;
+    long long atraso_ini = inicio - liberacao;
+    if (t->jobs == 0 || resp < t->resp_min) t->resp_min = resp;
+    if (resp > t->resp_max) t->resp_max = resp;
+    if (t->jobs == 0 || atraso_ini < t->ini_min) t->ini_min = atraso_ini;
+    if (atraso_ini > t->ini_max) t->ini_max = atraso_ini;
+    if (cpu > t->exec_max) t->exec_max = cpu;
+    t->resp_soma += resp;
+    if (resp > rt_deadline_us(t) * 1000LL)
+        t->perdas++;
+    if (rt_estourou)
+        t->estouros++;
+    if (t->jobs < t->log_cap)
+        t->log[t->jobs] = (RtJob){ liberacao - ex->t0, inicio - ex->t0, fim - ex->t0,
+                                   cpu, rt_estourou };
+    t->jobs++;
+}
+
+/* ----------------------------------------------------------
+ * Modo RM: cada thread se libera sozinha
+ * ---------------------------------------------------------- */
+static void *rt_thread_rm(void *arg) {
+    RtTarefa *t = arg;
+    RtExec *ex = t->exec;
+    rt_criar_timer_cpu(t);
+
+    const long long periodo = t->periodo_us * 1000LL;
+    for (long long k = 0;; k++) {
+        long long liberacao = ex->t0 + k * periodo;
+        rt_dormir_ate(liberacao);      // já passou? retorna na hora (job atrasado)
+        if (atomic_load(&ex->parar))
+            break;
+        rt_rodar_job(t, liberacao);
+    }
+    return NULL;
+}
+
+/* ----------------------------------------------------------
+ * Modo EDF: despachante + tarefas que esperam no semáforo
+ * ---------------------------------------------------------- */
+static void *rt_thread_edf(void *arg) {
+    RtTarefa *t = arg;
+    RtExec *ex = t->exec;
+    rt_criar_timer_cpu(t);
+
+    const long long periodo = t->periodo_us * 1000LL;
+    for (;;) {
+        while (sem_wait(&t->sem_job) != 0 && errno == EINTR)
+            ;
+        if (atomic_load(&ex->parar))
+            break;
+        // O job pendente mais antigo é o de índice 'concluidos' (só nós o mudamos).
+        rt_rodar_job(t, ex->t0 + t->concluidos * periodo);
+        pthread_mutex_lock(&ex->mtx);
+        t->concluidos++;
+        pthread_cond_signal(&ex->cond);    // despachante reordena as prioridades
+        pthread_mutex_unlock(&ex->mtx);
+    }
+    return NULL;
+}
+
+// Deadline absoluto do job pendente mais antigo (chamar com ex->mtx travado).
+static inline long long rt_deadline_abs(RtExec *ex, RtTarefa *t) {
+    return ex->t0 + t->concluidos * t->periodo_us * 1000LL + rt_deadline_us(t) * 1000LL;
+}
+
+static void *rt_despachante(void *arg) {
+    RtExec *ex = arg;
+    int n = ex->n;
+    int ativas[n], novos[n];
+
+    pthread_mutex_lock(&ex->mtx);
+    while (!atomic_load(&ex->parar)) {
+        long long agora = rt_agora_ns();
+        long long proxima = agora + 1000000000LL;
+
+        // 1) Liberações vencidas.
+        for (int i = 0; i < n; i++) {
+            RtTarefa *t = &ex->t[i];
+            const long long periodo = t->periodo_us * 1000LL;
+            novos[i] = 0;
+            while (ex->t0 + t->liberados * periodo <= agora) {
+                t->liberados++;
+                novos[i]++;
+            }
+            long long prox = ex->t0 + t->liberados * periodo;
+            if (prox < proxima)
+                proxima = prox;
+        }
+
+        // 2) Ordena as tarefas ativas pelo deadline absoluto (inserção: n é pequeno).
+        int na = 0;
+        for (int i = 0; i < n; i++) {
+            if (ex->t[i].liberados == ex->t[i].concluidos)
+                continue;
+            long long d = rt_deadline_abs(ex, &ex->t[i]);
+            int j = na++;
+            while (j > 0 && rt_deadline_abs(ex, &ex->t[ativas[j - 1]]) > d) {
+                ativas[j] = ativas[j - 1];
+                j--;
+            }
+            ativas[j] = i;
+        }
+
+        // 3) Deadline mais próximo → prioridade mais alta. Só troca o que mudou,
+        //    e ANTES de acordar a tarefa (ela já acorda com a prioridade certa).
+        for (int r = 0; r < na; r++) {
+            RtTarefa *t = &ex->t[ativas[r]];
+            int prio = RT_PRIO_TOPO - r;
+            if (ex->rt && t->prio != prio) {
+                struct sched_param sp = { .sched_priority = prio };
+                pthread_setschedparam(t->th, SCHED_FIFO, &sp);
+            }
+            t->prio = prio;
+        }
+        for (int i = 0; i < n; i++)
+            while (novos[i]-- > 0)
+                sem_post(&ex->t[i].sem_job);
+
+        // 4) Dorme até a próxima liberação ou até alguma tarefa terminar.
+        struct timespec ts = rt_ts(proxima);
+        pthread_cond_timedwait(&ex->cond, &ex->mtx, &ts);
+    }
+    pthread_mutex_unlock(&ex->mtx);
+    return NULL;
+}
+
+/* ----------------------------------------------------------
+ * Criação de threads (SCHED_FIFO ou SCHED_OTHER, presas na CPU)
+ * ---------------------------------------------------------- */
+static int rt_criar_thread(RtExec *ex, pthread_t *th, void *(*fn)(void *), void *arg, int prio) {
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (ex->cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(ex->cpu, &cpus);
+        pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+    if (ex->rt) {
+        struct sched_param sp = { .sched_priority = prio };
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &sp);
+    }
+    int rc = pthread_create(th, &attr, fn, arg);
+    pthread_attr_destroy(&attr);
+    return rc;
+}
+
+// Testa se o processo pode usar SCHED_FIFO (root ou CAP_SYS_NICE/RLIMIT_RTPRIO)
+static inline int rt_tem_privilegio(void) {
+    struct sched_param sp = { .sched_priority = 1 };
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp) != 0)
+        return 0;
+    sp.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &sp);
+    return 1;
+}
+
+/* ----------------------------------------------------------
+ * API principal
+ * ---------------------------------------------------------- */
+// Executa o conjunto de tarefas por 'duracao_ms'. Retorna 0 (ok) ou -1.
+static inline int rt_executar(RtTarefa *t, int n, RtModo modo, long duracao_ms, int cpu) {
+    static RtExec ex;
+    memset(&ex, 0, sizeof(ex));
+    ex.modo = modo;
+    ex.t = t;
+    ex.n = n;
+    ex.cpu = cpu;
+    ex.rt = rt_tem_privilegio();
+    if (!ex.rt)
+        fprintf(stderr, "⚠️  Sem privilégio para SCHED_FIFO (use sudo ou CAP_SYS_NICE): "
+                        "rodando em SCHED_OTHER, sem garantias.\n");
+
+    // Timer de CPU → SIGRTMIN → marca o estouro na thread que estourou.
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = rt_ao_estouro;
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGRTMIN, &sa, NULL);
+
+    // Prioridades RM: ordena por período (empate: deadline, depois índice).
+    for (int i = 0; i < n; i++) {
+        int rank = 0;
+        for (int j = 0; j < n; j++) {
+            if (t[j].periodo_us < t[i].periodo_us ||
+                (t[j].periodo_us == t[i].periodo_us &&
+                 (rt_deadline_us(&t[j]) < rt_deadline_us(&t[i]) ||
+                  (rt_deadline_us(&t[j]) == rt_deadline_us(&t[i]) && j < i))))
+                rank++;
+        }
+        if (modo == RT_RM)
+            t[i].prio = RT_PRIO_TOPO - rank;
+        else if (modo == RT_EDF)
+            t[i].prio = 1;                     // o despachante ajusta
+        // RT_FP: mantém a prioridade escolhida pelo usuário
+        t[i].exec = &ex;
+        t[i].jobs = t[i].perdas = t[i].estouros = 0;
+        t[i].resp_min = t[i].resp_max = t[i].resp_soma = 0;
+        t[i].ini_min = t[i].ini_max = t[i].exec_max = 0;
+        t[i].liberados = t[i].concluidos = 0;
+        t[i].tem_timer = 0;
+        t[i].log_cap = duracao_ms * 1000LL / t[i].periodo_us + 2;
+        t[i].log = calloc(t[i].log_cap, sizeof(RtJob));
+        if (t[i].log == NULL) {
+            perror("calloc");
+            return -1;
+        }
+        sem_init(&t[i].sem_job, 0, 0);
+    }
+
+    pthread_mutex_init(&ex.mtx, NULL);
+    pthread_condattr_t ca;
+    pthread_condattr_init(&ca);
+    pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+    pthread_cond_init(&ex.cond, &ca);
+    pthread_condattr_destroy(&ca);
+
+    // t0 um pouco no futuro: todas as threads já existem na primeira liberação.
+    ex.t0 = rt_agora_ns() + 20000000LL;
+    for (int i = 0; i < n; i++) {
+        int rc = rt_criar_thread(&ex, &t[i].th, modo == RT_EDF ? rt_thread_edf : rt_thread_rm,
+                                 &t[i], t[i].prio);
+        if (rc != 0) {
+            fprintf(stderr, "pthread_create(%s): %s\n", t[i].nome, strerror(rc));
+            exit(1);
+        }
+    }
+    pthread_t desp;
+    if (modo == RT_EDF) {
+        int rc = rt_criar_thread(&ex, &desp, rt_despachante, &ex, RT_PRIO_DESPACHANTE);
+        if (rc != 0) {
+            fprintf(stderr, "pthread_create(despachante): %s\n", strerror(rc));
+            exit(1);
+        }
+    }
+
+    rt_dormir_ate(ex.t0 + duracao_ms * 1000000LL);
+    atomic_store(&ex.parar, 1);
+    if (modo == RT_EDF) {
+        pthread_mutex_lock(&ex.mtx);
+        pthread_cond_signal(&ex.cond);
+        pthread_mutex_unlock(&ex.mtx);
+        pthread_join(desp, NULL);
+        for (int i = 0; i < n; i++)
+            sem_post(&t[i].sem_job);
+    }
+    for (int i = 0; i < n; i++) {
+        pthread_join(t[i].th, NULL);
+        if (t[i].tem_timer)
+            timer_delete(t[i].timer_cpu);
+        sem_destroy(&t[i].sem_job);
+    }
+    pthread_cond_destroy(&ex.cond);
+    pthread_mutex_destroy(&ex.mtx);
+    return 0;
+}
+
+static inline void rt_relatorio(const RtTarefa *t, int n) {
+    printf("%-8s %7s %7s %7s %5s %6s %6s %6s %8s %8s %8s %8s %8s\n",
+           "tarefa", "T(ms)", "C(ms)", "D(ms)", "prio", "jobs", "perdas", "estour",
+           "R mín", "R méd", "R máx", "jit ini", "exec máx");
+    for (int i = 0; i < n; i++) {
+        const RtTarefa *x = &t[i];
+        if (x->jobs == 0) {
+            printf("%-8s sem jobs\n", x->nome);
+            continue;
+        }
+        char prio[8];
+        if (x->exec != NULL && x->exec->modo == RT_EDF)
+            snprintf(prio, sizeof(prio), "din");      // EDF: muda a cada job
+        else
+            snprintf(prio, sizeof(prio), "%d", x->prio);
+        printf("%-8s %7.2f %7.2f %7.2f %5s %6lld %6lld %6lld %8.3f %8.3f %8.3f %8.3f %8.3f\n",
+               x->nome, x->periodo_us / 1e3, x->wcet_us / 1e3, rt_deadline_us(x) / 1e3,
+               prio, x->jobs, x->perdas, x->estouros,
+               x->resp_min / 1e6, x->resp_soma / 1e6 / x->jobs, x->resp_max / 1e6,
+               (x->ini_max - x->ini_min) / 1e6, x->exec_max / 1e6);
+    }
+    printf("(R = tempo de resposta; jit ini = variação do atraso de início; tempos em ms)\n");
+}
+
+static inline void rt_liberar(RtTarefa *t, int n) {
+    for (int i = 0; i < n; i++) {
+        free(t[i].log);
+        t[i].log = NULL;
+    }
+}
+
+#endif // RT_PERIODIC_H
@@ -3,12 +3,22 @@
  *
  * Ideia:
  *  - Criamos um processo FILHO que muda sua política de escalonamento para SCHED_FIFO
- *    (tempo real) com prioridade alta e entra em busy-loop. De tempos em tempos ele
- *    imprime uma mensagem.
- *  - O processo PAI fica em SCHED_OTHER (CFS) e tenta imprimir a cada 500 ms.
+ *    (tempo real) com prioridade alta e entra em busy-loop.
+ *  - O processo PAI fica em SCHED_OTHER (CFS) e tenta dar um "batimento" a cada 500 ms.
  *  - Quando os dois disputam o MESMO core, o FILHO tende a ocupar a CPU quase o tempo todo,
  *    e o PAI só aparece ocasionalmente (quando sobra tempo ou por throttling de RT).
  *
+ * Medição (em vez de só "ver" as mensagens):
+ *  - O PAI agenda cada batimento num instante ABSOLUTO (t0 + k*500 ms) e registra
+ *    quando realmente voltou a rodar → atraso de cada batimento.
+ *  - O FILHO amostra CLOCK_THREAD_CPUTIME_ID (tempo de CPU que ele de fato recebeu)
+ *    e publica em memória compartilhada; também guarda a fatia de CPU em janelas
+ *    de 100 ms, o que deixa visível o padrão do throttling (roda ~950 ms, para ~50 ms).
+ *  - Lemos kernel.sched_rt_runtime_us / sched_rt_period_us e comparamos a fatia
+ *    medida do FILHO com o limite configurado.
+ *  - Saída: linha do tempo por batimento + resumo, para comparar configurações de
+ *    throttling e kernels de forma objetiva.
+ *
  * Como compilar:
  *   gcc rt_starvation.c -o rt_starvation
  *
@@ -16,11 +26,14 @@
  *   sudo taskset -c 0 ./rt_starvation
  *
  * Observação:
- *   - É preciso sudo (ou CAP_SYS_NICE) para elevar a tarefa a SCHED_FIFO.
+ *   - É preciso sudo (ou CAP_SYS_NICE) para elevar a tarefa a SCHED_FIFO. Sem permissão
+ *     o FILHO avisa e continua em SCHED_OTHER (os números servem de referência).
  *   - O kernel Linux costuma ter "RT throttling" (limita uso de CPU por tarefas RT),
  *     o que pode permitir que o PAI ainda imprima um pouco. Para DEMONSTRAÇÃO,
  *     você pode desativar temporariamente: sudo sysctl -w kernel.sched_rt_runtime_us=-1
  *     e depois restaurar (por ex.): sudo sysctl -w kernel.sched_rt_runtime_us=950000
+ *   - Sem throttling o PAI pode nem rodar: por isso o FILHO se encerra sozinho ao fim
+ *     do experimento e o resumo é impresso mesmo assim.
  */
 
 #define _GNU_SOURCE           // habilita APIs GNU como sched_setscheduler
@@ -30,11 +43,111 @@
 #include <stdlib.h>          // exit, _exit
 #include <errno.h>           // errno
 #include <sys/wait.h>        // wait, waitpid
+#include <sys/mman.h>        // mmap (memória compartilhada PAI/FILHO)
 #include <signal.h>          // kill
-#include <time.h>            // nanosleep
+#include <stdatomic.h>       // publicação do tempo de CPU do FILHO
+#include <time.h>            // clock_nanosleep, clock_gettime
 #include <string.h>          // strerror
 
+#define N_BATIMENTOS   10               // batimentos do PAI
+#define PERIODO_MS     500              // intervalo pretendido entre batimentos
+#define JANELA_MS      100              // janela de amostragem da CPU do FILHO
+#define MAX_JANELAS    ((N_BATIMENTOS * PERIODO_MS) / JANELA_MS + 64)
+#define FOLGA_MS       2000             // FILHO para sozinho t0 + duração + folga
+
+// ----------------------------------------------------------------------------
+// Área compartilhada (MAP_SHARED): o FILHO escreve, o PAI lê
+// ----------------------------------------------------------------------------
+typedef struct {
+    atomic_int  rt_ok;                  // 1 = FILHO conseguiu SCHED_FIFO, -1 = não
+    atomic_llong cpu_ns;                // CPU acumulada do FILHO (CLOCK_THREAD_CPUTIME_ID)
+    atomic_int  n_janelas;              // janelas completas publicadas
+    long long   janela_cpu_ns[MAX_JANELAS];  // CPU do FILHO em cada janela de 100 ms
+} Compartilhado;
+
+static long long ns_de(clockid_t relogio) {
+    struct timespec ts;
+    clock_gettime(relogio, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Lê um inteiro de /proc/sys (retorna 0 se não conseguir).
+static int ler_sysctl(const char *caminho, long *valor) {
+    FILE *f = fopen(caminho, "r");
+    if (f == NULL)
+        return 0;
+    int ok = fscanf(f, "%ld", valor) == 1;
+    fclose(f);
+    return ok;
+}
+
+// ----------------------------------------------------------------------------
+// FILHO: busy-loop em SCHED_FIFO, amostrando o próprio tempo de CPU
+// ----------------------------------------------------------------------------
+static void filho(Compartilhado *sh, long long t0) {
+    // Define prioridade alta (intervalo válido: 1..99 para SCHED_FIFO/SCHED_RR).
+    struct sched_param sp = { .sched_priority = 80 };
+
+    // Tenta trocar a política de escalonamento do processo atual (pid 0 = self).
+    if (sched_setscheduler(0, SCHED_FIFO, &sp) != 0) {
+        // Se falhar, provavelmente falta permissão (sudo/CAP_SYS_NICE).
+        fprintf(stderr, "sched_setscheduler falhou: %s (FILHO segue em SCHED_OTHER)\n",
+                strerror(errno));
+        atomic_store(&sh->rt_ok, -1);
+    } else {
+        atomic_store(&sh->rt_ok, 1);
+    }
+
+    // Busy-loop contínuo: não fazemos sleep nem yield, para não "ceder" a CPU.
+    // A cada N iterações lemos os relógios (syscall barata, mas não de graça).
+    const long long fim = t0 + (N_BATIMENTOS * PERIODO_MS + FOLGA_MS) * 1000000LL;
+    const long long janela = JANELA_MS * 1000000LL;
+    long long prox_janela = t0 + janela;
+    long long cpu_inicio_janela = ns_de(CLOCK_THREAD_CPUTIME_ID);
+    volatile unsigned long long x = 0;
+    const unsigned long long N = 64 * 1024;
+
+    for (;;) {
+        x++;
+        if ((x % N) != 0)
+            continue;
+        long long cpu = ns_de(CLOCK_THREAD_CPUTIME_ID);
+        long long agora = ns_de(CLOCK_MONOTONIC);
+        atomic_store_explicit(&sh->cpu_ns, cpu, memory_order_relaxed);
+
+        // Fecha as janelas vencidas. Se o FILHO ficou parado (throttling), a
+        // CPU toda cai na janela atual e as anteriores ficam com 0.
+        while (agora >= prox_janela) {
+            int n = atomic_load_explicit(&sh->n_janelas, memory_order_relaxed);
+            if (n < MAX_JANELAS) {
+                sh->janela_cpu_ns[n] = cpu - cpu_inicio_janela;
+                atomic_store_explicit(&sh->n_janelas, n + 1, memory_order_release);
+            }
+            cpu_inicio_janela = cpu;
+            prox_janela += janela;
+        }
+        if (agora >= fim)
+            break;                       // encerra mesmo sem throttling
+    }
+    _exit(0);
+}
+
 int main(void) {
+    Compartilhado *sh = mmap(NULL, sizeof(*sh), PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (sh == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    long rt_runtime = 0, rt_period = 0;
+    int tem_rt_runtime = ler_sysctl("/proc/sys/kernel/sched_rt_runtime_us", &rt_runtime);
+    int tem_rt_period  = ler_sysctl("/proc/sys/kernel/sched_rt_period_us", &rt_period);
+
+    cpu_set_t cpus;
+    int n_cpus = sched_getaffinity(0, sizeof(cpus), &cpus) == 0 ? CPU_COUNT(&cpus) : -1;
+
+    long long t0 = ns_de(CLOCK_MONOTONIC);
     pid_t pid = fork();      // cria um processo filho
 
     if (pid < 0) {
@@ -47,54 +160,91 @@ int main(void) {
         // ================================
         // FILHO: Política de tempo real
         // ================================
-        // Define prioridade alta (intervalo válido: 1..99 para SCHED_FIFO/SCHED_RR).
-        struct sched_param sp = { .sched_priority = 80 };
-
-        // Tenta trocar a política de escalonamento do processo atual (pid 0 = self).
-        if (sched_setscheduler(0, SCHED_FIFO, &sp) != 0) {
-            // Se falhar, provavelmente falta permissão (sudo/CAP_SYS_NICE).
-            fprintf(stderr, "sched_setscheduler falhou: %s\n", strerror(errno));
-            _exit(1);
-        }
+        filho(sh, t0);
+    }
 
-        // Texto fixo a ser impresso pelo FILHO em intervalos de iteração.
-        static const char msg[] = "FILHO (SCHED_FIFO) rodando: prioridade sobre o PAI\n";
+    // ================================
+    // PAI: Tarefa normal (SCHED_OTHER/CFS)
+    // ================================
+    // O pai dá "batimentos" a cada 500 ms, agendados em instantes absolutos.
+    // Se o FILHO (RT) estiver pegando a CPU continuamente no MESMO core,
+    // os batimentos atrasam; medimos quanto.
+    printf("=== Starvation: FILHO SCHED_FIFO x PAI SCHED_OTHER ===\n");
+    if (tem_rt_runtime && tem_rt_period) {
+        if (rt_runtime < 0)
+            printf("RT throttling: DESLIGADO (sched_rt_runtime_us = -1)\n");
+        else
+            printf("RT throttling: %ld us a cada %ld us → limite de %.1f%% para tarefas RT\n",
+                   rt_runtime, rt_period, 100.0 * rt_runtime / rt_period);
+    } else {
+        printf("RT throttling: não foi possível ler /proc/sys/kernel/sched_rt_*\n");
+    }
+    printf("CPUs permitidas: %d%s\n\n", n_cpus,
+           n_cpus > 1 ? "  (⚠️  rode com taskset -c 0 para disputarem o mesmo core)" : "");
 
-        // Busy-loop contínuo: não fazemos sleep nem yield, para não "ceder" a CPU.
-        // A cada N iterações, escrevemos uma mensagem (write em STDOUT evita buffering).
-        volatile unsigned long long x = 0;
-        const unsigned long long N = 80ULL * 1000ULL * 1000ULL; // ajuste a frequência
+    printf("%4s %10s %10s %10s %14s\n", "bat", "previsto", "real", "atraso", "CPU do FILHO");
+    printf("%4s %10s %10s %10s %14s\n", "", "(ms)", "(ms)", "(ms)", "no intervalo");
 
-        for (;;) {
-            x++;
-            if ((x % N) == 0) {
-                // write() é async-signal-safe e não depende de buffering da stdio.
-                ssize_t _unused = write(STDOUT_FILENO, msg, sizeof(msg) - 1);
-                (void)_unused; // evita warning de variável não usada
-            }
-        }
+    double atraso_ms[N_BATIMENTOS];
+    long long real_ant = t0, cpu_ant = 0;
+    for (int i = 0; i < N_BATIMENTOS; i++) {
+        long long previsto = t0 + (long long)(i + 1) * PERIODO_MS * 1000000LL;
+        struct timespec ts = { .tv_sec = previsto / 1000000000LL,
+                               .tv_nsec = previsto % 1000000000LL };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+            ;                    // pausa o PAI; o FILHO RT segue rodando
 
-        // (nunca chega aqui)
-        _exit(0);
+        long long real = ns_de(CLOCK_MONOTONIC);
+        long long cpu = atomic_load_explicit(&sh->cpu_ns, memory_order_relaxed);
+        atraso_ms[i] = (real - previsto) / 1e6;
 
-    } else {
-        // ================================
-        // PAI: Tarefa normal (SCHED_OTHER/CFS)
-        // ================================
-        // O pai apenas imprime "batimentos" a cada 500 ms.
-        // Se o FILHO (RT) estiver pegando a CPU continuamente no MESMO core,
-        // essas mensagens do pai tendem a atrasar/aparecer menos.
-        for (int i = 0; i < 10; i++) {
-            struct timespec ts = { .tv_sec = 0, .tv_nsec = 500 * 1000 * 1000 }; // 500 ms
-            nanosleep(&ts, NULL);  // pausa o PAI; o FILHO RT segue rodando
-
-            printf("PAI (SCHED_OTHER) ainda vivo (i=%d)\n", i);
-            fflush(stdout);        // força saída imediata (stdout é bufferizado)
-        }
+        printf("%4d %10.1f %10.1f %10.1f %13.1f%%\n", i,
+               (previsto - t0) / 1e6, (real - t0) / 1e6, atraso_ms[i],
+               100.0 * (cpu - cpu_ant) / (real - real_ant));
+        fflush(stdout);          // força saída imediata (stdout é bufferizado)
+        real_ant = real;
+        cpu_ant = cpu;
+    }
+    long long t_fim = ns_de(CLOCK_MONOTONIC);
+    long long cpu_total = atomic_load(&sh->cpu_ns);
 
-        // Encerra o filho ao final da demonstração, para não ficar consumindo CPU.
-        kill(pid, SIGKILL);
-        waitpid(pid, NULL, 0);
-        return 0;
+    // Encerra o filho ao final da demonstração, para não ficar consumindo CPU.
+    kill(pid, SIGKILL);
+    waitpid(pid, NULL, 0);
+
+    // ------------------------------ Resumo ---------------------------------
+    double soma = 0, max = atraso_ms[0], min = atraso_ms[0];
+    for (int i = 0; i < N_BATIMENTOS; i++) {
+        soma += atraso_ms[i];
+        if (atraso_ms[i] > max) max = atraso_ms[i];
+        if (atraso_ms[i] < min) min = atraso_ms[i];
+    }
+
+    // Janelas de 100 ms: mostram se o FILHO foi pausado pelo throttling.
+    int nj = atomic_load_explicit(&sh->n_janelas, memory_order_acquire);
+    double jmin = 100, jmax = 0;
+    int j_cheias = 0;
+    for (int j = 0; j < nj; j++) {
+        double p = 100.0 * sh->janela_cpu_ns[j] / (JANELA_MS * 1e6);
+        if (p < jmin) jmin = p;
+        if (p > jmax) jmax = p;
+        if (p >= 99.0) j_cheias++;
     }
+
+    printf("\n=== Resumo ===\n");
+    printf("Política do FILHO:        %s\n",
+           atomic_load(&sh->rt_ok) == 1 ? "SCHED_FIFO prio 80" : "SCHED_OTHER (sem permissão para RT)");
+    printf("Atraso dos batimentos:    min %.1f ms | médio %.1f ms | máx %.1f ms\n",
+           min, soma / N_BATIMENTOS, max);
+    printf("CPU do FILHO (total):     %.1f%% de %.1f s\n",
+           100.0 * cpu_total / (t_fim - t0), (t_fim - t0) / 1e9);
+    if (nj > 0)
+        printf("Janelas de %d ms:        %d | fatia mín %.1f%% | máx %.1f%% | %d com >= 99%%\n",
+               JANELA_MS, nj, jmin, jmax, j_cheias);
+    if (tem_rt_runtime && tem_rt_period && rt_runtime >= 0)
+        printf("Limite de throttling:     %.1f%% → sobra teórica p/ o PAI: %.0f ms a cada %.0f ms\n",
+               100.0 * rt_runtime / rt_period, (rt_period - rt_runtime) / 1e3, rt_period / 1e3);
+
+    munmap(sh, sizeof(*sh));
+    return 0;
 }
@@ -0,0 +1,598 @@
+/*
+ * Análise de escalonabilidade OFFLINE + simulador de eventos discretos
+ *
+ * Ideia:
+ *  - Lê a descrição de um conjunto de tarefas (período, WCET, deadline,
+ *    prioridade e recursos compartilhados) e responde ANTES de rodar:
+ *      * testes de utilização: Liu & Layland, limite hiperbólico e EDF (U <= 1);
+ *      * RTA (Response Time Analysis) para prioridade fixa — a dada no
+ *        arquivo (FP), Rate Monotonic (RM) e Deadline Monotonic (DM):
+ *            R = C + B + soma_{j de prioridade >= i} ceil(R / Tj) * Cj
+ *        onde B é o bloqueio por recursos sob teto de prioridade (PCP/ICPP):
+ *        a maior seção crítica de uma tarefa MENOS prioritária num recurso
+ *        cujo teto é >= a prioridade da tarefa;
+ *      * EDF com D < T: critério de demanda de processador (dbf(t) <= t).
+ *  - Simulador de eventos discretos (pula de evento em evento, não de tick
+ *    em tick) para prioridade fixa preemptiva (com ICPP nos recursos) e EDF:
+ *    simula horas de escalonamento por segundo e mede o pior tempo de
+ *    resposta observado. Com liberação síncrona (instante crítico) o máximo
+ *    simulado deve bater com o RTA.
+ *  - Opcional (-m): roda o mesmo conjunto de verdade no Linux com
+ *    rt_periodic.h (threads SCHED_FIFO na CPU 0, carga sintética de C) e
+ *    compara previsto x simulado x medido.
+ *
+ * Formato do arquivo (tempos em ms, aceita frações; '#' inicia comentário):
+ *   # nome   T      C     D     prio   recursos
+ *   TaskA    500    2     -     2      console:0.5
+ *   TaskB    1000   3     -     1      console:0.5,spi:1
+ *   D '-' ou 0 → D = T.  prio '-' ou 0 → só RM/DM/EDF (maior número = maior
+ *   prioridade, como no FreeRTOS).  recursos '-' → nenhum.
+ *
+ * Como compilar:
+ *   gcc -O2 -pthread sched_analysis.c -o sched_analysis -lrt -lm
+ *
+ * Como executar:
+ *   ./sched_analysis tarefas_exemplo01.txt
+ *   ./sched_analysis tarefas_exemplo01.txt -s 36000       (10 h simuladas)
+ *   sudo ./sched_analysis tarefas_exemplo01.txt -m 10000  (+ 10 s medidos)
+ *
+ * Observações:
+ *   - Tarefas de MESMA prioridade são tratadas como interferência mútua no RTA
+ *     (limite superior, cobre o time slicing do FreeRTOS); no simulador e na
+ *     medição elas rodam em ordem FIFO.
+ *   - O simulador executa as seções críticas no início do job (ICPP). O EDF
+ *     simulado e o medido ignoram os recursos.
+ *   - A simulação parte do instante crítico (todas liberadas em t = 0): ali a
+ *     tarefa mais prioritária roda primeiro e NÃO sofre o bloqueio B. Por isso
+ *     R sim pode ficar abaixo do RTA exatamente pelo valor de B.
+ *   - O RTA assume D <= T.
+ */
+
+#include "rt_periodic.h"
+#include <math.h>            // ceil, pow
+#include <stdint.h>          // INT64_MAX
+
+#define MAX_TAREFAS   32
+#define MAX_REC       8      // recursos por tarefa
+#define MAX_RECURSOS  16     // recursos distintos no conjunto
+#define MAX_PENDENTES 256    // jobs pendentes por tarefa no simulador
+
+// ----------------------------------------------------------------------------
+// Conjunto de tarefas (tempos em µs)
+// ----------------------------------------------------------------------------
+typedef struct {
+    char nome[32];
+    long long T, C, D;
+    int prio;                         // 0 = não informada
+    int nrec;
+    int rec[MAX_REC];                 // índice em nomes_rec
+    long long cs[MAX_REC];            // duração da seção crítica
+} Tarefa;
+
+static Tarefa ts[MAX_TAREFAS];
+static int n;
+static char nomes_rec[MAX_RECURSOS][32];
+static int n_rec;
+
+static long long ms_para_us(const char *s) {
+    if (strcmp(s, "-") == 0)
+        return 0;
+    return llround(atof(s) * 1000.0);
+}
+
+static int indice_recurso(const char *nome) {
+    for (int i = 0; i < n_rec; i++)
+        if (strcmp(nomes_rec[i], nome) == 0)
+            return i;
+    if (n_rec == MAX_RECURSOS)
+        return -1;
+    snprintf(nomes_rec[n_rec], sizeof(nomes_rec[0]), "%s", nome);
+    return n_rec++;
+}
+
+static int ler_arquivo(const char *caminho) {
+    FILE *f = fopen(caminho, "r");
+    if (f == NULL) {
+        perror(caminho);
+        return -1;
+    }
+    char linha[512];
+    int num = 0;
+    while (fgets(linha, sizeof(linha), f)) {
+        num++;
+        char *c = strchr(linha, '#');
+        if (c) *c = '\0';
+        char nome[32], T[32], C[32], D[32], P[32], R[256] = "-";
+        int campos = sscanf(linha, "%31s %31s %31s %31s %31s %255s", nome, T, C, D, P, R);
+        if (campos <= 0)
+            continue;
+        if (campos < 5 || n == MAX_TAREFAS) {
+            fprintf(stderr, "%s:%d: linha inválida (nome T C D prio [recursos])\n", caminho, num);
+            fclose(f);
+            return -1;
+        }
+        Tarefa *t = &ts[n];
+        snprintf(t->nome, sizeof(t->nome), "%s", nome);
+        t->T = ms_para_us(T);
+        t->C = ms_para_us(C);
+        t->D = ms_para_us(D);
+        if (t->D == 0) t->D = t->T;
+        t->prio = strcmp(P, "-") == 0 ? 0 : atoi(P);
+        if (t->T <= 0 || t->C <= 0 || t->C > t->D) {
+            fprintf(stderr, "%s:%d: exige T > 0 e 0 < C <= D\n", caminho, num);
+            fclose(f);
+            return -1;
+        }
+
+        // recursos: nome:ms,nome:ms
+        if (strcmp(R, "-") != 0) {
+            long long soma = 0;
+            for (char *tok = strtok(R, ","); tok && t->nrec < MAX_REC; tok = strtok(NULL, ",")) {
+                char *dp = strchr(tok, ':');
+                if (dp == NULL) {
+                    fprintf(stderr, "%s:%d: recurso sem duração: %s\n", caminho, num, tok);
+                    fclose(f);
+                    return -1;
+                }
+                *dp = '\0';
+                int r = indice_recurso(tok);
+                if (r < 0) {
+                    fprintf(stderr, "%s:%d: recursos demais\n", caminho, num);
+                    fclose(f);
+                    return -1;
+                }
+                t->rec[t->nrec] = r;
+                t->cs[t->nrec] = ms_para_us(dp + 1);
+                soma += t->cs[t->nrec++];
+            }
+            if (soma > t->C) {
+                fprintf(stderr, "%s:%d: seções críticas somam mais que C\n", caminho, num);
+                fclose(f);
+                return -1;
+            }
+        }
+        n++;
+    }
+    fclose(f);
+    if (n == 0) {
+        fprintf(stderr, "%s: nenhuma tarefa\n", caminho);
+        return -1;
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Atribuição de prioridades (maior número = maior prioridade)
+// ----------------------------------------------------------------------------
+typedef enum { POL_FP, POL_RM, POL_DM, POL_EDF } Politica;
+static const char *NOME_POL[] = { "FP (arquivo)", "RM", "DM", "EDF" };
+
+static void atribuir_prioridades(Politica pol, int prio[]) {
+    for (int i = 0; i < n; i++) {
+        if (pol == POL_FP) {
+            prio[i] = ts[i].prio;
+            continue;
+        }
+        // Posto: quantas tarefas são "mais urgentes" que i (empate: índice).
+        int posto = 0;
+        for (int j = 0; j < n; j++) {
+            long long a = pol == POL_RM ? ts[j].T : ts[j].D;
+            long long b = pol == POL_RM ? ts[i].T : ts[i].D;
+            if (a < b || (a == b && j < i))
+                posto++;
+        }
+        prio[i] = n - posto;
+    }
+}
+
+// Teto de cada recurso = maior prioridade entre as tarefas que o usam.
+static void calcular_tetos(const int prio[], int teto[]) {
+    for (int r = 0; r < n_rec; r++)
+        teto[r] = 0;
+    for (int i = 0; i < n; i++)
+        for (int k = 0; k < ts[i].nrec; k++)
+            if (prio[i] > teto[ts[i].rec[k]])
+                teto[ts[i].rec[k]] = prio[i];
+}
+
+// ----------------------------------------------------------------------------
+// RTA (prioridade fixa) com bloqueio por teto de prioridade
+// ----------------------------------------------------------------------------
+static long long bloqueio(int i, const int prio[], const int teto[]) {
+    long long B = 0;
+    for (int j = 0; j < n; j++) {
+        if (prio[j] >= prio[i])
+            continue;                           // só tarefas MENOS prioritárias bloqueiam
+        for (int k = 0; k < ts[j].nrec; k++)
+            if (teto[ts[j].rec[k]] >= prio[i] && ts[j].cs[k] > B)
+                B = ts[j].cs[k];
+    }
+    return B;
+}
+
+// Retorna R (µs) ou -1 se passar do deadline.
+static long long rta(int i, const int prio[], long long B) {
+    long long R = ts[i].C + B, ant = -1;
+    while (R != ant) {
+        if (R > ts[i].D)
+            return -1;
+        ant = R;
+        R = ts[i].C + B;
+        for (int j = 0; j < n; j++)
+            if (j != i && prio[j] >= prio[i])
+                R += ((ant + ts[j].T - 1) / ts[j].T) * ts[j].C;
+    }
+    return R;
+}
+
+// ----------------------------------------------------------------------------
+// EDF: utilização e demanda de processador
+// ----------------------------------------------------------------------------
+static long long mdc(long long a, long long b) {
+    while (b) { long long t = a % b; a = b; b = t; }
+    return a;
+}
+
+// dbf(t) = soma max(0, floor((t - Di) / Ti) + 1) * Ci
+static long long dbf(long long t) {
+    long long d = 0;
+    for (int i = 0; i < n; i++)
+        if (t >= ts[i].D)
+            d += ((t - ts[i].D) / ts[i].T + 1) * ts[i].C;
+    return d;
+}
+
+// Retorna 1 escalonável, 0 não, -1 inconclusivo; *t_falha = primeiro t com dbf(t) > t.
+// *L_dbf = até onde o dbf foi verificado (0 se bastou U <= 1, com D = T).
+static int teste_edf(double U, long long *t_falha, long long *L_dbf) {
+    int d_igual_t = 1;
+    for (int i = 0; i < n; i++)
+        if (ts[i].D != ts[i].T) d_igual_t = 0;
+    if (U > 1.0 + 1e-12)
+        return 0;
+    if (d_igual_t)
+        return 1;                               // Liu & Layland: U <= 1 basta
+
+    // Limite de verificação: L* (U < 1) ou hiperperíodo.
+    long long hiper = 1;
+    for (int i = 0; i < n && hiper > 0; i++) {
+        long long g = mdc(hiper, ts[i].T);
+        hiper = (hiper / g > INT64_MAX / ts[i].T) ? -1 : hiper / g * ts[i].T;
+    }
+    long long L = 0;
+    for (int i = 0; i < n; i++)
+        if (ts[i].D > L) L = ts[i].D;
+    if (U < 1.0) {
+        double extra = 0;
+        for (int i = 0; i < n; i++)
+            extra += (double)(ts[i].T - ts[i].D) * ts[i].C / ts[i].T;
+        double Lestrela = extra / (1.0 - U);
+        if (Lestrela > L) L = (long long)Lestrela + 1;
+        if (hiper > 0 && hiper < L) L = hiper;
+    } else {
+        if (hiper < 0 || hiper > 1000000000000LL)
+            return -1;
+        L = hiper;
+    }
+
+    // Verifica dbf(t) <= t em cada deadline absoluto até L.
+    long long prox[MAX_TAREFAS];
+    for (int i = 0; i < n; i++) prox[i] = ts[i].D;
+    *L_dbf = L;
+    for (;;) {
+        long long t = INT64_MAX;
+        for (int i = 0; i < n; i++)
+            if (prox[i] < t) t = prox[i];
+        if (t > L)
+            return 1;
+        if (dbf(t) > t) {
+            *t_falha = t;
+            return 0;
+        }
+        for (int i = 0; i < n; i++)
+            if (prox[i] == t) prox[i] += ts[i].T;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Simulador de eventos discretos
+// ----------------------------------------------------------------------------
+typedef struct {
+    long long jobs, perdas, resp_max, resp_soma;
+    long long descartados;                     // fila de pendentes estourou
+} ResSim;
+
+typedef struct {
+    long long lib[MAX_PENDENTES];              // liberações pendentes (fila circular)
+    int ini, qtd;
+    int seg;                                   // segmento atual do job da frente
+    long long resta;                           // tempo restante no segmento
+    int travou;                                // já entrou na seção crítica (ICPP)
+    long long prox_lib;
+} EstadoSim;
+
+// Segmentos do job: seções críticas primeiro, depois o resto de C.
+static long long dur_seg(int i, int seg) {
+    if (seg < ts[i].nrec)
+        return ts[i].cs[seg];
+    long long soma = 0;
+    for (int k = 0; k < ts[i].nrec; k++) soma += ts[i].cs[k];
+    return ts[i].C - soma;
+}
+
+static void proximo_job(EstadoSim *e, int i) {
+    e->seg = 0;
+    e->travou = 0;
+    while (e->seg <= ts[i].nrec && (e->resta = dur_seg(i, e->seg)) == 0)
+        e->seg++;
+}
+
+// prio == NULL → EDF. Simula [0, duracao) com liberação síncrona em t = 0.
+static void simular(const int prio[], const int teto[], long long duracao, ResSim res[]) {
+    EstadoSim est[MAX_TAREFAS];
+    memset(est, 0, sizeof(est));
+    memset(res, 0, n * sizeof(ResSim));
+    int rodando = -1;
+    long long agora = 0;
+
+    for (;;) {
+        // 1) Liberações no instante atual.
+        long long prox_evento = INT64_MAX;
+        for (int i = 0; i < n; i++) {
+            EstadoSim *e = &est[i];
+            while (e->prox_lib <= agora) {
+                if (e->qtd == MAX_PENDENTES) {
+                    res[i].descartados++;
+                } else {
+                    e->lib[(e->ini + e->qtd) % MAX_PENDENTES] = e->prox_lib;
+                    if (e->qtd++ == 0)
+                        proximo_job(e, i);
+                }
+                e->prox_lib += ts[i].T;
+            }
+            if (e->prox_lib < prox_evento)
+                prox_evento = e->prox_lib;
+        }
+        if (agora >= duracao)
+            break;
+
+        // 2) Escolhe quem roda. FP: maior prioridade efetiva (teto, se já
+        //    travou o recurso). EDF: menor deadline absoluto. Empate: quem já
+        //    estava rodando, depois a liberação mais antiga.
+        int esc = -1;
+        long long chave_esc = 0;
+        for (int i = 0; i < n; i++) {
+            EstadoSim *e = &est[i];
+            if (e->qtd == 0)
+                continue;
+            long long chave;
+            if (prio) {
+                int p = prio[i];
+                if (e->travou && e->seg < ts[i].nrec && teto[ts[i].rec[e->seg]] > p)
+                    p = teto[ts[i].rec[e->seg]];
+                chave = -(long long)p;
+            } else {
+                chave = e->lib[e->ini] + ts[i].D;
+            }
+            if (esc < 0 || chave < chave_esc ||
+                (chave == chave_esc && i == rodando) ||
+                (chave == chave_esc && esc != rodando &&
+                 e->lib[e->ini] < est[esc].lib[est[esc].ini])) {
+                esc = i;
+                chave_esc = chave;
+            }
+        }
+        rodando = esc;
+
+        // 3) Avança até o próximo evento (liberação ou fim de segmento).
+        long long ate = prox_evento < duracao ? prox_evento : duracao;
+        if (esc < 0) {
+            agora = ate;                       // CPU ociosa
+            continue;
+        }
+        EstadoSim *e = &est[esc];
+        e->travou = 1;
+        long long dt = ate - agora;
+        if (e->resta < dt) dt = e->resta;
+        agora += dt;
+        e->resta -= dt;
+        if (e->resta > 0)
+            continue;
+
+        // Fim de segmento: próximo segmento ou fim do job.
+        e->travou = 0;
+        while (++e->seg <= ts[esc].nrec && (e->resta = dur_seg(esc, e->seg)) == 0)
+            ;
+        if (e->seg <= ts[esc].nrec)
+            continue;
+        long long r = agora - e->lib[e->ini];
+        res[esc].jobs++;
+        res[esc].resp_soma += r;
+        if (r > res[esc].resp_max) res[esc].resp_max = r;
+        if (r > ts[esc].D) res[esc].perdas++;
+        e->ini = (e->ini + 1) % MAX_PENDENTES;
+        if (--e->qtd > 0)
+            proximo_job(e, esc);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Medição real (rt_periodic.h)
+// ----------------------------------------------------------------------------
+static void corpo_medicao(RtTarefa *t, void *arg) {
+    (void)arg;
+    rt_girar_cpu_us(t->wcet_us * 95 / 100);    // 95% de C: folga para o overhead
+}
+
+static void medir(Politica pol, const int prio[], long duracao_ms, RtTarefa rt[]) {
+    memset(rt, 0, n * sizeof(RtTarefa));
+    int pmax = 0;
+    for (int i = 0; i < n; i++)
+        if (prio && prio[i] > pmax) pmax = prio[i];
+    for (int i = 0; i < n; i++) {
+        rt[i].nome = ts[i].nome;
+        rt[i].periodo_us = ts[i].T;
+        rt[i].wcet_us = ts[i].C;
+        rt[i].deadline_us = ts[i].D;
+        rt[i].corpo = corpo_medicao;
+        // Mesma ordem relativa, mapeada para o topo da faixa SCHED_FIFO.
+        if (prio)
+            rt[i].prio = RT_PRIO_TOPO - (pmax - prio[i]) > 1 ? RT_PRIO_TOPO - (pmax - prio[i]) : 1;
+    }
+    rt_executar(rt, n, pol == POL_EDF ? RT_EDF : RT_FP, duracao_ms, 0);
+}
+
+// ----------------------------------------------------------------------------
+// Programa principal
+// ----------------------------------------------------------------------------
+static double agora_s(void) {
+    return rt_agora_ns() / 1e9;
+}
+
+static void imprimir_ms(long long us, int largura) {
+    if (us < 0) printf(" %*s", largura, "> D");
+    else        printf(" %*.3f", largura, us / 1e3);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s arquivo [-s segundos_simulados] [-m ms_medidos]\n", argv[0]);
+        return 1;
+    }
+    double sim_s = 3600;
+    long medir_ms = 0;
+    int op;
+    optind = 2;
+    while ((op = getopt(argc, argv, "s:m:")) != -1) {
+        switch (op) {
+        case 's': sim_s = atof(optarg); break;
+        case 'm': medir_ms = atol(optarg); break;
+        default: return 1;
+        }
+    }
+    if (ler_arquivo(argv[1]) != 0)
+        return 1;
+
+    // ---------------------------- Conjunto --------------------------------
+    double U = 0, hiperb = 1;
+    int tem_prio = 1;
+    for (int i = 0; i < n; i++) {
+        double u = (double)ts[i].C / ts[i].T;
+        U += u;
+        hiperb *= u + 1;
+        if (ts[i].prio == 0) tem_prio = 0;
+    }
+    double liu = n * (pow(2.0, 1.0 / n) - 1);
+
+    printf("=== Conjunto de tarefas: %s ===\n", argv[1]);
+    printf("%-10s %9s %9s %9s %5s  %s\n", "tarefa", "T(ms)", "C(ms)", "D(ms)", "prio", "recursos");
+    for (int i = 0; i < n; i++) {
+        char p[8] = "-";
+        if (ts[i].prio) snprintf(p, sizeof(p), "%d", ts[i].prio);
+        printf("%-10s %9.3f %9.3f %9.3f %5s  ", ts[i].nome, ts[i].T / 1e3, ts[i].C / 1e3,
+               ts[i].D / 1e3, p);
+        if (ts[i].nrec == 0) printf("-");
+        for (int k = 0; k < ts[i].nrec; k++)
+            printf("%s%s:%.3f", k ? "," : "", nomes_rec[ts[i].rec[k]], ts[i].cs[k] / 1e3);
+        printf("\n");
+    }
+    printf("\nU = %.4f | Liu-Layland (RM) = %.4f → %s | hiperbólico prod(Ui+1) = %.4f → %s\n",
+           U, liu, U <= liu ? "ok" : "inconclusivo",
+           hiperb, hiperb <= 2.0 ? "ok" : "inconclusivo");
+
+    // ------------------------ Prioridade fixa -----------------------------
+    Politica pols[] = { POL_FP, POL_RM, POL_DM };
+    long long dur_sim = (long long)(sim_s * 1e6);
+    for (int p = 0; p < 3; p++) {
+        Politica pol = pols[p];
+        if (pol == POL_FP && !tem_prio)
+            continue;
+        int prio[MAX_TAREFAS], teto[MAX_RECURSOS];
+        atribuir_prioridades(pol, prio);
+        calcular_tetos(prio, teto);
+
+        ResSim res[MAX_TAREFAS];
+        double t0 = agora_s();
+        simular(prio, teto, dur_sim, res);
+        double dt = agora_s() - t0;
+
+        RtTarefa rt[MAX_TAREFAS];
+        if (medir_ms > 0)
+            medir(pol, prio, medir_ms, rt);
+
+        printf("\n=== %s: RTA x simulação (%.0f s simulados em %.3f s = %.0f h/s)%s ===\n",
+               NOME_POL[pol], sim_s, dt, dt > 0 ? sim_s / 3600 / dt : 0.0,
+               medir_ms > 0 ? " x medição" : "");
+        printf("%-10s %5s %9s %9s %9s %4s %9s %8s", "tarefa", "prio", "B(ms)", "R RTA",
+               "D", "ok?", "R sim", "perdas");
+        if (medir_ms > 0) printf(" %9s %8s", "R medido", "perdas");
+        printf("\n");
+        int todas = 1;
+        for (int i = 0; i < n; i++) {
+            long long B = bloqueio(i, prio, teto);
+            long long R = rta(i, prio, B);
+            if (R < 0) todas = 0;
+            printf("%-10s %5d", ts[i].nome, prio[i]);
+            imprimir_ms(B, 9);
+            imprimir_ms(R, 9);
+            imprimir_ms(ts[i].D, 9);
+            printf(" %4s", R >= 0 ? "sim" : "NÃO");
+            imprimir_ms(res[i].resp_max, 9);
+            printf(" %8lld", res[i].perdas);
+            if (medir_ms > 0) {
+                imprimir_ms(rt[i].resp_max / 1000, 9);
+                printf(" %8lld", rt[i].perdas);
+            }
+            printf("\n");
+        }
+        printf("→ %s\n", todas ? "escalonável (RTA: todo R <= D)" : "NÃO escalonável pelo RTA");
+        if (n_rec > 0)
+            printf("  (simulação síncrona: o bloqueio B do RTA só aparece com defasagem entre tarefas)\n");
+        if (medir_ms > 0)
+            rt_liberar(rt, n);
+    }
+
+    // ------------------------------ EDF -----------------------------------
+    long long t_falha = 0, L_dbf = 0;
+    int edf = teste_edf(U, &t_falha, &L_dbf);
+    ResSim res[MAX_TAREFAS];
+    double t0 = agora_s();
+    simular(NULL, NULL, dur_sim, res);
+    double dt = agora_s() - t0;
+    RtTarefa rt[MAX_TAREFAS];
+    if (medir_ms > 0)
+        medir(POL_EDF, NULL, medir_ms, rt);
+
+    printf("\n=== EDF: teste analítico x simulação (%.0f s simulados em %.3f s)%s ===\n",
+           sim_s, dt, medir_ms > 0 ? " x medição" : "");
+    if (edf == 1 && L_dbf == 0)
+        printf("Teste: escalonável (U = %.4f <= 1 com D = T%s)\n", U,
+               n_rec ? "; recursos ignorados" : "");
+    else if (edf == 1)
+        printf("Teste: escalonável (dbf(t) <= t em todo deadline até %.3f ms, U = %.4f%s)\n",
+               L_dbf / 1e3, U, n_rec ? "; recursos ignorados" : "");
+    else if (edf == 0 && U > 1)
+        printf("Teste: NÃO escalonável (U = %.4f > 1)\n", U);
+    else if (edf == 0)
+        printf("Teste: NÃO escalonável (demanda dbf(%.3f ms) > %.3f ms)\n",
+               t_falha / 1e3, t_falha / 1e3);
+    else
+        printf("Teste: inconclusivo (hiperperíodo grande demais)\n");
+    printf("%-10s %9s %9s %8s", "tarefa", "D", "R sim", "perdas");
+    if (medir_ms > 0) printf(" %9s %8s", "R medido", "perdas");
+    printf("\n");
+    for (int i = 0; i < n; i++) {
+        printf("%-10s", ts[i].nome);
+        imprimir_ms(ts[i].D, 9);
+        imprimir_ms(res[i].resp_max, 9);
+        printf(" %8lld", res[i].perdas);
+        if (medir_ms > 0) {
+            imprimir_ms(rt[i].resp_max / 1000, 9);
+            printf(" %8lld", rt[i].perdas);
+        }
+        printf("\n");
+    }
+    if (medir_ms > 0)
+        rt_liberar(rt, n);
+    return 0;
+}
@@ -0,0 +1,270 @@
+/*
+ * sched_stats.h — estatísticas de escalonamento POR THREAD (coletor)
+ *
+ * Ideia:
+ *  - Em vez de deduzir o comportamento do escalonador pelos printf, medimos o
+ *    que o próprio kernel contabiliza para cada thread:
+ *      /proc/self/task/<tid>/schedstat   → tempo na CPU, tempo ESPERANDO na
+ *                                          fila de prontos (runqueue) e número
+ *                                          de vezes que entrou na CPU
+ *      /proc/self/task/<tid>/status      → trocas de contexto voluntárias
+ *                                          (bloqueou: sleep, mutex, E/S) e
+ *                                          involuntárias (foi preemptada)
+ *      relógio de CPU da thread          → CLOCK_THREAD_CPUTIME_ID, lido de fora
+ *                                          com pthread_getcpuclockid()
+ *  - Cada thread se registra (ss_registrar) e ganha um slot fixo: os arquivos
+ *    são abertos UMA vez e relidos com pread() num buffer da pilha. O coletor
+ *    (uma thread própria, período configurável) não aloca nada por amostra.
+ *  - Antes de terminar a thread chama ss_sair(): é a última amostra (depois
+ *    disso /proc/self/task/<tid> some e o relógio de CPU deixa de valer).
+ *  - ss_relatorio() mostra, por thread: CPU, espera na runqueue, maior espera
+ *    num intervalo de amostragem, fatias e trocas de contexto.
+ *
+ * Uso típico:
+ *   static SsColetor col;
+ *   ss_iniciar(&col, 10);                       // amostra a cada 10 ms
+ *   // dentro de cada thread:
+ *   int slot = ss_registrar(&col, "worker");
+ *   ...
+ *   ss_sair(&col, slot);
+ *   // na main, depois dos joins:
+ *   ss_parar(&col);
+ *   ss_relatorio(&col);
+ *
+ * Observação:
+ *   - schedstat existe com CONFIG_SCHED_INFO (padrão nas distribuições). Sem
+ *     ele as colunas de runqueue ficam em "-".
+ *   - A thread do coletor também disputa CPU: com período curto numa máquina
+ *     de 1 CPU ela aparece (pouco) nas medições das outras. Ela roda em
+ *     SCHED_OTHER: com threads RT ocupando a CPU ela atrasa e o "esp máx"
+ *     passa a cobrir intervalos maiores (os totais continuam exatos).
+ */
+
+#ifndef SCHED_STATS_H
+#define SCHED_STATS_H
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE           // gettid
+#endif
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SS_MAX_THREADS 64
+
+typedef struct {
+    long long cpu_ns;                 // schedstat: tempo na CPU
+    long long espera_ns;              // schedstat: tempo na runqueue
+    long long fatias;                 // schedstat: vezes que entrou na CPU
+    long long voluntarias, involuntarias;
+    long long relogio_ns;             // CLOCK_THREAD_CPUTIME_ID
+} SsAmostra;
+
+typedef struct {
+    const char *nome;
+    pid_t tid;
+    int fd_schedstat, fd_status;
+    clockid_t relogio;
+    int ativo;                        // ainda dá para amostrar
+    int tem_schedstat;
+    SsAmostra ini, ult;
+    long long espera_max_ns;          // maior espera entre duas amostras
+    long long amostras;
+} SsThread;
+
+typedef struct {
+    SsThread th[SS_MAX_THREADS];
+    atomic_int n;
+    pthread_mutex_t mtx;              // coletor x ss_sair no mesmo slot
+    pthread_t coletor;
+    long periodo_ms;
+    atomic_int parar;
+    int rodando;
+} SsColetor;
+
+// ----------------------------------------------------------------------------
+// Leitura (sem alocação: pread + buffer na pilha)
+// ----------------------------------------------------------------------------
+static inline long long ss_campo(const char *buf, const char *campo) {
+    const char *p = strstr(buf, campo);
+    return p ? atoll(p + strlen(campo)) : 0;
+}
+
+// Lê uma amostra do slot. Retorna 0 se a thread não existe mais.
+static inline int ss_ler(SsThread *t, SsAmostra *a) {
+    char buf[2048];
+    ssize_t n;
+    if (t->tem_schedstat) {
+        n = pread(t->fd_schedstat, buf, sizeof(buf) - 1, 0);
+        if (n <= 0)
+            return 0;
+        buf[n] = '\0';
+        if (sscanf(buf, "%lld %lld %lld", &a->cpu_ns, &a->espera_ns, &a->fatias) != 3)
+            return 0;
+    }
+    n = pread(t->fd_status, buf, sizeof(buf) - 1, 0);
+    if (n <= 0)
+        return 0;
+    buf[n] = '\0';
+    a->voluntarias   = ss_campo(buf, "\nvoluntary_ctxt_switches:");
+    a->involuntarias = ss_campo(buf, "\nnonvoluntary_ctxt_switches:");
+    struct timespec ts;
+    if (clock_gettime(t->relogio, &ts) != 0)
+        return 0;
+    a->relogio_ns = ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    return 1;
+}
+
+// Amostra um slot (com o mutex do coletor travado).
+static inline void ss_amostrar(SsThread *t) {
+    if (!t->ativo)
+        return;
+    SsAmostra a = t->ult;
+    if (!ss_ler(t, &a)) {
+        t->ativo = 0;                 // a thread terminou sem ss_sair
+        return;
+    }
+    long long d = a.espera_ns - t->ult.espera_ns;
+    if (d > t->espera_max_ns)
+        t->espera_max_ns = d;
+    t->ult = a;
+    t->amostras++;
+}
+
+static inline void* ss_coletor(void *arg) {
+    SsColetor *c = arg;
+    struct timespec prox;
+    clock_gettime(CLOCK_MONOTONIC, &prox);
+    while (!atomic_load(&c->parar)) {
+        prox.tv_nsec += c->periodo_ms * 1000000L;
+        prox.tv_sec  += prox.tv_nsec / 1000000000L;
+        prox.tv_nsec %= 1000000000L;
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &prox, NULL);
+        pthread_mutex_lock(&c->mtx);
+        int n = atomic_load(&c->n);
+        for (int i = 0; i < n; i++)
+            ss_amostrar(&c->th[i]);
+        pthread_mutex_unlock(&c->mtx);
+    }
+    return NULL;
+}
+
+// ----------------------------------------------------------------------------
+// API
+// ----------------------------------------------------------------------------
+// periodo_ms <= 0: sem coletor periódico (só as amostras de registro e saída).
+static inline int ss_iniciar(SsColetor *c, long periodo_ms) {
+    memset(c, 0, sizeof(*c));
+    pthread_mutex_init(&c->mtx, NULL);
+    c->periodo_ms = periodo_ms;
+    if (periodo_ms <= 0)
+        return 0;
+    int rc = pthread_create(&c->coletor, NULL, ss_coletor, c);
+    if (rc != 0) {
+        fprintf(stderr, "ss_iniciar: pthread_create: %s\n", strerror(rc));
+        return -1;
+    }
+    c->rodando = 1;
+    return 0;
+}
+
+// Chamada pela PRÓPRIA thread. Retorna o slot (-1 se não deu).
+static inline int ss_registrar(SsColetor *c, const char *nome) {
+    pid_t tid = gettid();
+    char caminho[64];
+    snprintf(caminho, sizeof(caminho), "/proc/self/task/%d/status", tid);
+    int fd_status = open(caminho, O_RDONLY | O_CLOEXEC);
+    if (fd_status < 0) {
+        fprintf(stderr, "ss_registrar(%s): %s: %s\n", nome, caminho, strerror(errno));
+        return -1;
+    }
+    snprintf(caminho, sizeof(caminho), "/proc/self/task/%d/schedstat", tid);
+    int fd_sched = open(caminho, O_RDONLY | O_CLOEXEC);
+
+    pthread_mutex_lock(&c->mtx);
+    int i = atomic_load(&c->n);
+    if (i == SS_MAX_THREADS) {
+        pthread_mutex_unlock(&c->mtx);
+        close(fd_status);
+        if (fd_sched >= 0)
+            close(fd_sched);
+        return -1;
+    }
+    SsThread *t = &c->th[i];
+    memset(t, 0, sizeof(*t));
+    t->nome = nome;
+    t->tid = tid;
+    t->fd_status = fd_status;
+    t->fd_schedstat = fd_sched;
+    t->tem_schedstat = fd_sched >= 0;
+    pthread_getcpuclockid(pthread_self(), &t->relogio);
+    t->ativo = ss_ler(t, &t->ini);
+    t->ult = t->ini;
+    atomic_store(&c->n, i + 1);       // só agora o coletor enxerga o slot
+    pthread_mutex_unlock(&c->mtx);
+    return i;
+}
+
+// Chamada pela PRÓPRIA thread antes de terminar: amostra final.
+static inline void ss_sair(SsColetor *c, int slot) {
+    if (slot < 0)
+        return;
+    pthread_mutex_lock(&c->mtx);
+    ss_amostrar(&c->th[slot]);
+    c->th[slot].ativo = 0;
+    pthread_mutex_unlock(&c->mtx);
+}
+
+// Para o coletor e fecha os arquivos (chamar depois dos joins).
+static inline void ss_parar(SsColetor *c) {
+    if (c->rodando) {
+        atomic_store(&c->parar, 1);
+        pthread_join(c->coletor, NULL);
+        c->rodando = 0;
+    }
+    int n = atomic_load(&c->n);
+    for (int i = 0; i < n; i++) {
+        SsThread *t = &c->th[i];
+        ss_amostrar(t);
+        t->ativo = 0;
+        close(t->fd_status);
+        if (t->tem_schedstat)
+            close(t->fd_schedstat);
+    }
+}
+
+static inline void ss_relatorio(const SsColetor *c) {
+    int n = atomic_load(&c->n);
+    printf("\n=== Escalonamento por thread (kernel: schedstat + status) ===\n");
+    printf("%-10s %7s %9s %9s %9s %6s %9s %8s %8s %8s\n", "thread", "tid", "CPU", "relógio",
+           "espera", "esp%", "esp máx", "fatias", "volunt.", "preempt.");
+    printf("%-10s %7s %9s %9s %9s %6s %9s %8s %8s %8s\n", "", "", "(ms)", "(ms)", "(ms)", "",
+           "(ms)", "", "", "");
+    for (int i = 0; i < n; i++) {
+        const SsThread *t = &c->th[i];
+        const SsAmostra *a = &t->ini, *b = &t->ult;
+        double cpu = (b->cpu_ns - a->cpu_ns) / 1e6, esp = (b->espera_ns - a->espera_ns) / 1e6;
+        printf("%-10s %7d ", t->nome, t->tid);
+        if (t->tem_schedstat)
+            printf("%9.1f %9.1f %9.1f %5.1f%% %9.2f %8lld ", cpu,
+                   (b->relogio_ns - a->relogio_ns) / 1e6, esp,
+                   cpu + esp > 0 ? 100.0 * esp / (cpu + esp) : 0.0,
+                   t->espera_max_ns / 1e6, b->fatias - a->fatias);
+        else
+            printf("%9s %9.1f %9s %6s %9s %8s ", "-", (b->relogio_ns - a->relogio_ns) / 1e6,
+                   "-", "-", "-", "-");
+        printf("%8lld %8lld\n", b->voluntarias - a->voluntarias,
+               b->involuntarias - a->involuntarias);
+    }
+    if (c->periodo_ms > 0)
+        printf("(esp máx = maior espera na runqueue entre duas amostras de %ld ms)\n",
+               c->periodo_ms);
+}
+
+#endif
@@ -4,10 +4,16 @@
 // Compilação e execução:
 //   gcc semaphore_example.c -o semaphore_example -lpthread
 //   ./semaphore_example
+//
+// Mesma demo com o semáforo futex em espaço de usuário (futex_sem.h):
+//   gcc semaphore_example.c -o semaphore_example -lpthread -DUSE_FUTEX_SEM
 
 #include <stdio.h>
 #include <pthread.h>   // pthread_create, pthread_join
 #include <semaphore.h> // sem_t, sem_init, sem_wait, sem_post
+#ifdef USE_FUTEX_SEM     // só Linux: <linux/futex.h> não existe no macOS
+#include "futex_sem.h" // sem_* passa a ser o semáforo futex
+#endif
 
 // Declaração do semáforo (variável global para ser compartilhada entre threads)
 sem_t sem;
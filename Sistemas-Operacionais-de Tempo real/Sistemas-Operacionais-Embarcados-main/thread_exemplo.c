@@ -1,27 +1,509 @@
 // Exemplo de uso de threads Posix em C no Linux
-// Compilar com: gcc thread_exemplo.c -o thread_exemplo -lpthread
-// Executar ./thread_exemplo
+// Compilar com: gcc -O2 thread_exemplo.c -o thread_exemplo -lpthread
+// Executar ./thread_exemplo          (tarefas "Hello World" rodando no pool)
+//          ./thread_exemplo bench    (pool x pthread_create por tarefa)
 // (-lpthread é necessário para linkar a biblioteca de threads POSIX)
+//
+// Em vez de criar uma thread por tarefa, criamos um POOL com uma thread por
+// core. Cada thread (worker) tem sua própria fila dupla (deque Chase-Lev):
+//   - o dono empilha e desempilha no FUNDO (LIFO, sem disputa, sem lock);
+//   - workers ociosos "roubam" do TOPO de outro worker (FIFO, com CAS).
+// Uma tarefa pode criar subtarefas (fork) e esperar por elas (join) com
+// tp_grupo; enquanto espera, a thread executa outras tarefas em vez de dormir.
 
+#define _GNU_SOURCE
 #include <pthread.h>   // funções de threads (pthread_create, pthread_exit, etc.)
 #include <stdio.h>     // printf
 #include <stdlib.h>    // exit, malloc, etc.
-#include <unistd.h>    // sleep
+#include <unistd.h>    // sleep, sysconf
+#include <string.h>    // strcmp
+#include <stdatomic.h> // operações atômicas do deque
+#include <time.h>      // clock_gettime
+#include <limits.h>    // INT_MAX
 
-#define NUM_THREADS 5  // define um número fixo de threads
+#include "futex_sem.h" // futex_wait / futex_wake / cpu_relax
 
-// Função que cada thread criada vai executar
-void *print_hello(void *threadid)
+#define NUM_THREADS 5  // define um número fixo de tarefas da demonstração
+
+// ============================================================================
+// Deque Chase-Lev (versão C11 de Lê, Pop, Cohen e Zappa Nardelli, 2013)
+// ============================================================================
+typedef struct Tarefa Tarefa;
+
+typedef struct Vetor {
+    long tamanho;               // sempre potência de 2 (índice = i & (tamanho-1))
+    struct Vetor *anterior;     // vetores substituídos: um ladrão ainda pode
+                                // estar lendo deles, então só liberamos no fim
+    _Atomic(Tarefa *) item[];
+} Vetor;
+
+typedef struct {
+    _Alignas(64) atomic_long topo;   // ladrões retiram daqui
+    _Alignas(64) atomic_long base;   // o dono empilha/desempilha aqui
+    _Atomic(Vetor *) vetor;
+} Deque;
+
+static Vetor *vetor_novo(long tamanho, Vetor *anterior) {
+    Vetor *v = malloc(sizeof(Vetor) + tamanho * sizeof(_Atomic(Tarefa *)));
+    if (v == NULL) { perror("malloc"); exit(1); }
+    v->tamanho = tamanho;
+    v->anterior = anterior;
+    return v;
+}
+
+static void deque_init(Deque *d) {
+    atomic_init(&d->topo, 0);
+    atomic_init(&d->base, 0);
+    atomic_init(&d->vetor, vetor_novo(256, NULL));
+}
+
+static void deque_destroy(Deque *d) {
+    Vetor *v = atomic_load(&d->vetor);
+    while (v) {
+        Vetor *ant = v->anterior;
+        free(v);
+        v = ant;
+    }
+}
+
+// Só o DONO chama push/pop.
+static void deque_push(Deque *d, Tarefa *t) {
+    long b = atomic_load_explicit(&d->base, memory_order_relaxed);
+    long tp = atomic_load_explicit(&d->topo, memory_order_acquire);
+    Vetor *v = atomic_load_explicit(&d->vetor, memory_order_relaxed);
+    if (b - tp > v->tamanho - 1) {
+        // Cheio: dobra o vetor copiando os elementos vivos.
+        Vetor *novo = vetor_novo(v->tamanho * 2, v);
+        for (long i = tp; i < b; i++)
+            atomic_store_explicit(&novo->item[i & (novo->tamanho - 1)],
+                atomic_load_explicit(&v->item[i & (v->tamanho - 1)], memory_order_relaxed),
+                memory_order_relaxed);
+        atomic_store_explicit(&d->vetor, novo, memory_order_release);
+        v = novo;
+    }
+    atomic_store_explicit(&v->item[b & (v->tamanho - 1)], t, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);   // publica o item antes da base
+    atomic_store_explicit(&d->base, b + 1, memory_order_relaxed);
+}
+
+static Tarefa *deque_pop(Deque *d) {
+    long b = atomic_load_explicit(&d->base, memory_order_relaxed) - 1;
+    Vetor *v = atomic_load_explicit(&d->vetor, memory_order_relaxed);
+    atomic_store_explicit(&d->base, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);   // "reserva" o item antes de ler o topo
+    long tp = atomic_load_explicit(&d->topo, memory_order_relaxed);
+    Tarefa *t = NULL;
+    if (tp <= b) {
+        t = atomic_load_explicit(&v->item[b & (v->tamanho - 1)], memory_order_relaxed);
+        if (tp == b) {
+            // Último item: disputa com os ladrões pelo mesmo CAS no topo.
+            if (!atomic_compare_exchange_strong_explicit(&d->topo, &tp, tp + 1,
+                        memory_order_seq_cst, memory_order_relaxed))
+                t = NULL;
+            atomic_store_explicit(&d->base, b + 1, memory_order_relaxed);
+        }
+    } else {
+        atomic_store_explicit(&d->base, b + 1, memory_order_relaxed);   // vazio
+    }
+    return t;
+}
+
+// Qualquer outra thread chama steal.
+static Tarefa *deque_steal(Deque *d) {
+    long tp = atomic_load_explicit(&d->topo, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long b = atomic_load_explicit(&d->base, memory_order_acquire);
+    if (tp >= b)
+        return NULL;
+    Vetor *v = atomic_load_explicit(&d->vetor, memory_order_acquire);
+    Tarefa *t = atomic_load_explicit(&v->item[tp & (v->tamanho - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->topo, &tp, tp + 1,
+                memory_order_seq_cst, memory_order_relaxed))
+        return NULL;                              // outro ladrão (ou o dono) ganhou
+    return t;
+}
+
+// ============================================================================
+// Pool de threads com roubo de trabalho
+// ============================================================================
+// O grupo costuma morar na pilha de quem faz o join: assim que 'pendentes'
+// chega a 0 o tp_wait pode retornar e o quadro deixa de existir. Por isso o
+// decremento é o ÚLTIMO acesso ao grupo e quem espera dorme numa palavra do
+// pool (ThreadPool.joins), não no próprio grupo.
+typedef struct {
+    atomic_uint pendentes;      // subtarefas ainda não concluídas
+} tp_grupo;
+
+struct Tarefa {
+    void (*fn)(void *);
+    void *arg;
+    tp_grupo *grupo;            // NULL = tarefa "solta" (ninguém faz join)
+    Tarefa *prox;               // encadeamento na fila de injeção
+};
+
+typedef struct ThreadPool ThreadPool;
+
+typedef struct {
+    Deque dq;
+    pthread_t th;
+    int id;
+    unsigned semente;           // escolha pseudoaleatória da vítima de roubo
+    ThreadPool *pool;
+    long executadas, roubadas;  // estatísticas (só o próprio worker escreve)
+} Worker;
+
+struct ThreadPool {
+    int n;
+    Worker *w;
+    // Tarefas enviadas por threads que NÃO são workers (ex.: main)
+    pthread_mutex_t inj_mtx;
+    Tarefa *inj_ini, *inj_fim;
+    atomic_int inj_n;
+    // Workers ociosos dormem no futex 'eventos'
+    atomic_uint eventos;
+    atomic_int dormindo;
+    // tp_wait sem trabalho para ajudar dorme no futex 'joins', que avança
+    // sempre que algum grupo termina
+    atomic_uint joins;
+    atomic_int esperando_join;
+    atomic_int parar;
+};
+
+static _Thread_local Worker *worker_atual;   // NULL fora do pool
+
+static void tp_grupo_init(tp_grupo *g) {
+    atomic_init(&g->pendentes, 0);
+}
+
+static void acordar_ocioso(ThreadPool *p) {
+    // Par com o "dormindo++ ; procura trabalho" de worker_loop (Dekker):
+    // ou vemos o worker anunciado, ou ele vê a tarefa que acabamos de publicar.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&p->dormindo, memory_order_relaxed) > 0) {
+        atomic_fetch_add(&p->eventos, 1);
+        futex_wake(&p->eventos, 1, FUTEX_PRIVATE_FLAG);
+    }
+}
+
+// fork: agenda fn(arg); se 'g' != NULL, tp_wait(g) esperará por ela.
+static void tp_spawn(ThreadPool *p, tp_grupo *g, void (*fn)(void *), void *arg) {
+    Tarefa *t = malloc(sizeof(Tarefa));
+    if (t == NULL) { perror("malloc"); exit(1); }
+    *t = (Tarefa){ .fn = fn, .arg = arg, .grupo = g, .prox = NULL };
+    if (g)
+        atomic_fetch_add_explicit(&g->pendentes, 1, memory_order_relaxed);
+
+    Worker *w = worker_atual;
+    if (w && w->pool == p) {
+        deque_push(&w->dq, t);               // caminho rápido: deque local, sem lock
+    } else {
+        pthread_mutex_lock(&p->inj_mtx);
+        if (p->inj_fim) p->inj_fim->prox = t; else p->inj_ini = t;
+        p->inj_fim = t;
+        atomic_fetch_add(&p->inj_n, 1);
+        pthread_mutex_unlock(&p->inj_mtx);
+    }
+    acordar_ocioso(p);
+}
+
+static Tarefa *pegar_injetada(ThreadPool *p) {
+    if (atomic_load_explicit(&p->inj_n, memory_order_relaxed) == 0)
+        return NULL;
+    pthread_mutex_lock(&p->inj_mtx);
+    Tarefa *t = p->inj_ini;
+    if (t) {
+        p->inj_ini = t->prox;
+        if (p->inj_ini == NULL) p->inj_fim = NULL;
+        atomic_fetch_sub(&p->inj_n, 1);
+    }
+    pthread_mutex_unlock(&p->inj_mtx);
+    return t;
+}
+
+// Ordem de busca: deque próprio → fila de injeção → roubo dos outros.
+static Tarefa *buscar_tarefa(ThreadPool *p, Worker *w) {
+    Tarefa *t;
+    if ((t = deque_pop(&w->dq)) != NULL)
+        return t;
+    if ((t = pegar_injetada(p)) != NULL)
+        return t;
+    int inicio = (int)(rand_r(&w->semente) % p->n);
+    for (int i = 0; i < p->n; i++) {
+        Worker *v = &p->w[(inicio + i) % p->n];
+        if (v == w) continue;
+        if ((t = deque_steal(&v->dq)) != NULL) {
+            w->roubadas++;
+            return t;
+        }
+    }
+    return NULL;
+}
+
+static void executar(Worker *w, Tarefa *t) {   // só workers executam tarefas
+    tp_grupo *g = t->grupo;
+    ThreadPool *p = w->pool;
+    t->fn(t->arg);
+    free(t);
+    w->executadas++;
+    // release: quem fizer join enxerga tudo o que a tarefa escreveu.
+    // Depois deste decremento 'g' pode já não existir: daqui em diante só o pool.
+    if (g && atomic_fetch_sub_explicit(&g->pendentes, 1, memory_order_seq_cst) == 1) {
+        // Par com o "esperando_join++ ; lê joins ; relê pendentes" de tp_wait:
+        // ou ele vê pendentes == 0, ou nós o vemos esperando e acordamos.
+        atomic_fetch_add(&p->joins, 1);
+        if (atomic_load(&p->esperando_join) > 0)
+            futex_wake(&p->joins, INT_MAX, FUTEX_PRIVATE_FLAG);  // a palavra é de todos os grupos
+    }
+}
+
+// join: espera o grupo terminar. Um worker espera AJUDANDO (executa outras
+// tarefas enquanto isso); uma thread externa (ex.: main) apenas dorme.
+static void tp_wait(ThreadPool *p, tp_grupo *g) {
+    Worker *w = worker_atual;
+    if (w && w->pool != p)
+        w = NULL;
+    int falhas = 0;
+    while (atomic_load_explicit(&g->pendentes, memory_order_acquire) > 0) {
+        Tarefa *t = w ? buscar_tarefa(p, w) : NULL;
+        if (t) { executar(w, t); falhas = 0; continue; }
+        if (w && ++falhas < 64) { cpu_relax(); continue; }
+        // Nada para ajudar: dorme até ALGUM grupo acabar e confere o nosso.
+        atomic_fetch_add(&p->esperando_join, 1);
+        unsigned e = atomic_load(&p->joins);
+        if (atomic_load(&g->pendentes) > 0)
+            futex_wait(&p->joins, e, NULL, 0, FUTEX_PRIVATE_FLAG);
+        atomic_fetch_sub(&p->esperando_join, 1);
+        falhas = 0;
+    }
+}
+
+static void *worker_loop(void *arg) {
+    Worker *w = arg;
+    ThreadPool *p = w->pool;
+    worker_atual = w;
+    while (!atomic_load_explicit(&p->parar, memory_order_relaxed)) {
+        Tarefa *t = buscar_tarefa(p, w);
+        if (t) { executar(w, t); continue; }
+
+        // Sem trabalho: anuncia que vai dormir e procura mais uma vez.
+        unsigned e = atomic_load(&p->eventos);
+        atomic_fetch_add(&p->dormindo, 1);
+        t = buscar_tarefa(p, w);
+        if (t == NULL && !atomic_load(&p->parar))
+            futex_wait(&p->eventos, e, NULL, 0, FUTEX_PRIVATE_FLAG);
+        atomic_fetch_sub(&p->dormindo, 1);
+        if (t) executar(w, t);
+    }
+    return NULL;
+}
+
+static ThreadPool *tp_criar(int n) {
+    ThreadPool *p = calloc(1, sizeof(ThreadPool));
+    if (p == NULL) { perror("calloc"); exit(1); }
+    p->n = n;
+    if (posix_memalign((void **)&p->w, 64, n * sizeof(Worker)) != 0) {
+        perror("posix_memalign");
+        exit(1);
+    }
+    pthread_mutex_init(&p->inj_mtx, NULL);
+    for (int i = 0; i < n; i++) {
+        Worker *w = &p->w[i];
+        deque_init(&w->dq);
+        w->id = i;
+        w->semente = 0x9E3779B9u * (i + 1);
+        w->pool = p;
+        w->executadas = w->roubadas = 0;
+    }
+    for (int i = 0; i < n; i++)
+        pthread_create(&p->w[i].th, NULL, worker_loop, &p->w[i]);
+    return p;
+}
+
+static void tp_destruir(ThreadPool *p) {
+    atomic_store(&p->parar, 1);
+    atomic_fetch_add(&p->eventos, 1);
+    futex_wake(&p->eventos, p->n, FUTEX_PRIVATE_FLAG);
+    for (int i = 0; i < p->n; i++)
+        pthread_join(p->w[i].th, NULL);
+    for (int i = 0; i < p->n; i++)
+        deque_destroy(&p->w[i].dq);
+    pthread_mutex_destroy(&p->inj_mtx);
+    free(p->w);
+    free(p);
+}
+
+// ============================================================================
+// Demonstração: as tarefas "Hello World" agora rodam no pool
+// ============================================================================
+
+// Função que cada tarefa do pool vai executar
+void print_hello(void *threadid)
 {
-    // Mostra uma mensagem de início, identificando a thread
-    printf("%ld: Hello World!\n", (long) threadid);
+    // Mostra uma mensagem de início, identificando a tarefa e o worker
+    printf("%ld: Hello World! (worker %d)\n", (long) threadid, worker_atual->id);
 
-    // Simula um trabalho da thread: espera 5 segundos
-    sleep(5);
+    // Simula um trabalho da tarefa: espera 1 segundo
+    sleep(1);
 
     // Mostra uma mensagem final, após o "trabalho"
     printf("%ld: Bye bye World!\n", (long) threadid);
 
-    // Encerra a execução da thread de forma limpa
-    pthread_exit(NULL);
+    // Não usamos pthread_exit aqui: a thread é do pool e segue viva para
+    // executar a próxima tarefa.
+}
+
+// ============================================================================
+// Benchmark: pool com roubo de trabalho x pthread_create por tarefa
+// ============================================================================
+#define FIB_N        30     // fib(30) recursivo
+#define FIB_CORTE    12     // abaixo disso, resolve sequencialmente
+#define FLOOD_POOL   1000000
+#define FLOOD_PTH    20000  // pthread_create é caro demais para 1e6
+
+static ThreadPool *pool;
+static atomic_long criadas_pth;
+
+static inline double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static long fib_seq(int n) { return n < 2 ? n : fib_seq(n - 1) + fib_seq(n - 2); }
+
+typedef struct { int n; long res; } FibArg;
+
+// Divide e conquista no pool: fork de fib(n-1), executa fib(n-2) aqui, join.
+static void fib_pool(void *p) {
+    FibArg *a = p;
+    if (a->n < FIB_CORTE) { a->res = fib_seq(a->n); return; }
+    FibArg x = { a->n - 1, 0 }, y = { a->n - 2, 0 };
+    tp_grupo g;
+    tp_grupo_init(&g);
+    tp_spawn(pool, &g, fib_pool, &x);
+    fib_pool(&y);
+    tp_wait(pool, &g);
+    a->res = x.res + y.res;
+}
+
+// Mesma recursão, mas cada "fork" é um pthread_create.
+static void *fib_pth(void *p) {
+    FibArg *a = p;
+    if (a->n < FIB_CORTE) { a->res = fib_seq(a->n); return NULL; }
+    FibArg x = { a->n - 1, 0 }, y = { a->n - 2, 0 };
+    pthread_t th;
+    // Sem thread (EAGAIN: limite de threads/memória), resolve x aqui mesmo.
+    int criada = pthread_create(&th, NULL, fib_pth, &x) == 0;
+    if (criada)
+        atomic_fetch_add_explicit(&criadas_pth, 1, memory_order_relaxed);
+    else
+        fib_pth(&x);
+    fib_pth(&y);
+    if (criada)
+        pthread_join(th, NULL);
+    a->res = x.res + y.res;
+    return NULL;
+}
+
+// Tarefa minúscula: quase nenhum trabalho, mede só o custo de agendamento.
+static void tarefa_minima(void *p) {
+    volatile long x = (long)p;
+    x = x * 3 + 1;
+}
+
+static void *tarefa_minima_pth(void *p) { tarefa_minima(p); return NULL; }
+
+// Tarefa raiz do flood: gera todas as tarefas minúsculas de dentro de um worker
+// (vão para o deque dele e são roubadas pelos demais).
+static void flood_raiz(void *p) {
+    long n = (long)p;
+    tp_grupo g;
+    tp_grupo_init(&g);
+    for (long i = 0; i < n; i++)
+        tp_spawn(pool, &g, tarefa_minima, (void *)i);
+    tp_wait(pool, &g);
+}
+
+static long total_executadas(void) {
+    long s = 0;
+    for (int i = 0; i < pool->n; i++) s += pool->w[i].executadas;
+    return s;
+}
+
+static void benchmark(int ncores) {
+    printf("=== Benchmark: pool (%d workers) x pthread_create por tarefa ===\n\n", ncores);
+    printf("%-28s %12s %12s %14s\n", "carga", "tarefas", "tempo (s)", "tarefas/s");
+
+    // --- Divide e conquista ---
+    long antes = total_executadas();
+    FibArg raiz = { FIB_N, 0 };
+    tp_grupo g;
+    tp_grupo_init(&g);
+    double t0 = agora_s();
+    tp_spawn(pool, &g, fib_pool, &raiz);
+    tp_wait(pool, &g);
+    double dt = agora_s() - t0;
+    long n = total_executadas() - antes;
+    printf("%-28s %12ld %12.3f %14.0f   (fib=%ld)\n", "fib pool", n, dt, n / dt, raiz.res);
+
+    FibArg raiz2 = { FIB_N, 0 };
+    atomic_store(&criadas_pth, 0);
+    t0 = agora_s();
+    fib_pth(&raiz2);
+    dt = agora_s() - t0;
+    n = atomic_load(&criadas_pth);
+    printf("%-28s %12ld %12.3f %14.0f   (fib=%ld)\n", "fib pthread_create", n, dt, n / dt, raiz2.res);
+
+    // --- Enxurrada de tarefas minúsculas ---
+    antes = total_executadas();
+    tp_grupo_init(&g);
+    t0 = agora_s();
+    tp_spawn(pool, &g, flood_raiz, (void *)(long)FLOOD_POOL);
+    tp_wait(pool, &g);
+    dt = agora_s() - t0;
+    n = total_executadas() - antes - 1;   // desconta a tarefa raiz
+    printf("%-28s %12ld %12.3f %14.0f\n", "minúsculas pool", n, dt, n / dt);
+
+    t0 = agora_s();
+    pthread_t th[64];
+    int criada[64];
+    for (long i = 0; i < FLOOD_PTH; i += 64) {
+        for (int k = 0; k < 64; k++) {
+            criada[k] = pthread_create(&th[k], NULL, tarefa_minima_pth, (void *)(i + k)) == 0;
+            if (!criada[k])
+                tarefa_minima((void *)(i + k));
+        }
+        for (int k = 0; k < 64; k++)
+            if (criada[k])
+                pthread_join(th[k], NULL);
+    }
+    dt = agora_s() - t0;
+    n = (FLOOD_PTH + 63) / 64 * 64;
+    printf("%-28s %12ld %12.3f %14.0f\n", "minúsculas pthread_create", n, dt, n / dt);
+
+    printf("\nPor worker (executadas / roubadas):\n");
+    for (int i = 0; i < pool->n; i++)
+        printf("  worker %2d: %10ld / %ld\n", i, pool->w[i].executadas, pool->w[i].roubadas);
+}
+
+int main(int argc, char **argv)
+{
+    // Uma thread por core disponível
+    int ncores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncores < 1) ncores = 1;
+    pool = tp_criar(ncores);
+
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        benchmark(ncores);
+    } else {
+        printf("Pool com %d workers; enviando %d tarefas\n", ncores, NUM_THREADS);
+        tp_grupo g;
+        tp_grupo_init(&g);
+        for (long t = 0; t < NUM_THREADS; t++)
+            tp_spawn(pool, &g, print_hello, (void *)t);
+        tp_wait(pool, &g);   // join: espera todas as tarefas terminarem
+    }
+
+    tp_destruir(pool);
+    return 0;
 }